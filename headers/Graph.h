@@ -5,8 +5,11 @@
 #ifndef GRAPHENGINE_GRAPH_H
 #define GRAPHENGINE_GRAPH_H
 
+#include <array>
+#include <memory>
 #include <vector>
 #include <tuple>
+#include <functional>
 #include <iostream>
 #include <algorithm>
 
@@ -14,10 +17,20 @@ class Graph {
 private:
     bool directed;
     int nodeCount, edgeCount;
-    std::vector<std::vector<std::pair<int, double>>> adjacencyList;
+    /* Neighbor lists in blocks of 64 rows. Copies of a graph share the blocks, and a block is copied by the first
+     * write into it while shared, so a copy costs a pointer per 64 nodes and versions only differ by touched blocks.
+     * Rows past `nodeCount` in the last block stay empty. */
+    struct RowBlock {
+        std::array<std::vector<std::pair<int, double>>, 64> rows;
+    };
+    static constexpr int blockShift = 6, blockMask = 63;
+    std::vector<std::shared_ptr<RowBlock>> rowBlocks;
+    std::vector<std::pair<int, double>>& row(int nodeIndex);
 
 public:
     explicit Graph(int nodeCount = 0, bool directed = false);
+    Graph(int nodeCount, const std::vector<std::tuple<int, int, double>>& edges, bool directed = false);
+    Graph(int nodeCount, const std::function<void(int, std::vector<std::pair<int, double>>&)>& rowBuilder, bool directed = false);
     ~Graph();
     [[nodiscard]] bool isDirected() const;
     [[nodiscard]] int getNodeCount() const;
@@ -9,9 +9,21 @@
 #include <queue>
 
 #include "Graph.h"
+#include "subgraph.h"
 
 bool dfs(const Graph& graph);
+bool dfs(const SubgraphView& view);
 bool bfs(const Graph& graph, const std::pair<int, int>& objPair);
+bool bfs(const SubgraphView& view, const std::pair<int, int>& objPair);
+/* Distance of an unreachable pair in `floyd` and every search. DOUBLE_MAX ~ pow(2, 1024) ~ 1.e308, so the sum of
+ * two of them does not overflow. */
+constexpr double unreachable = 1.e150;
 std::vector<std::vector<double>> floyd(const Graph& graph);
+void distanceRow(const Graph& graph, int source, std::vector<double>& dist, bool hop = false);
+void distanceRow(const SubgraphView& view, int source, std::vector<double>& dist, bool hop = false);
+std::pair<double, std::vector<int>> bidirectionalBfs(const Graph& graph, const std::pair<int, int>& objPair, bool withPath = false);
+std::pair<double, std::vector<int>> bidirectionalDijkstra(const Graph& graph, const std::pair<int, int>& objPair, bool withPath = false);
+std::vector<double> batchDistance(const Graph& graph, const std::vector<std::pair<int, int>>& objPairs, bool weighted = false);
+std::vector<double> pageRank(const Graph& graph, double damping = .85, const std::vector<double>& personalization = {}, const std::vector<double>& initial = {}, double tolerance = 1.e-10, int maxIteration = 100);
 
 #endif // GRAPHENGINE_ALGORITHM_H
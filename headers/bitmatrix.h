@@ -0,0 +1,40 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_BITMATRIX_H
+#define GRAPHENGINE_BITMATRIX_H
+
+#include <cstdint>
+
+#include "Graph.h"
+
+/* Dense adjacency with one bit row per node, 1 bit per node pair instead of 16 bytes per edge. Rows are combined a
+ * 64-bit word at a time: a degree is a row popcount, common neighbors are AND + popcount of two rows and a search
+ * level is the OR of the frontier rows. Row i holds the out-neighbors of i. */
+class BitMatrix {
+private:
+    int nodeCount, rowWords;
+    bool directed;
+    std::vector<std::uint64_t> bits;
+    [[nodiscard]] const std::uint64_t* row(int nodeIndex) const;
+
+public:
+    BitMatrix();
+    explicit BitMatrix(const Graph& graph);
+    ~BitMatrix();
+    [[nodiscard]] int getNodeCount() const;
+    [[nodiscard]] bool isDirected() const;
+    [[nodiscard]] std::size_t memoryUsage() const;
+    [[nodiscard]] bool hasEdge(int from, int to) const;
+    [[nodiscard]] int degree(int nodeIndex) const;
+    void hopRow(int source, std::vector<double>& dist) const;
+    [[nodiscard]] std::vector<long long> triangles() const;
+};
+
+/* Edges per ordered node pair from which stats switch to a BitMatrix. The bit rows are then at least 16 times smaller
+ * than the lists, and AND + popcount triangles overtake the list scan at about 0.11 on Erdos-Renyi graphs. */
+constexpr double denseThreshold = 1. / 8.;
+bool isDense(const Graph& graph);
+
+#endif // GRAPHENGINE_BITMATRIX_H
@@ -0,0 +1,13 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_COMMUNITY_H
+#define GRAPHENGINE_COMMUNITY_H
+
+#include "Graph.h"
+
+double modularity(const Graph& graph, const std::vector<int>& community);
+std::pair<double, std::vector<int>> louvain(const Graph& graph, int passes = 0, double tolerance = 1.e-7);
+
+#endif // GRAPHENGINE_COMMUNITY_H
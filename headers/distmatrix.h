@@ -0,0 +1,36 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_DISTMATRIX_H
+#define GRAPHENGINE_DISTMATRIX_H
+
+#include <cstdint>
+#include <string>
+
+#include "Graph.h"
+
+/* All-pairs distances in one flat buffer. The layout is picked from the graph: an undirected graph keeps only the
+ * lower triangle, and a graph whose weights are all 1 keeps hop counts in the narrowest unsigned integer (1, 2 or 4
+ * bytes) that holds its longest distance, doubles otherwise. Unreachable pairs read as 1.e150, like `floyd`. */
+class DistanceMatrix {
+private:
+    int nodeCount, width; // Bytes per entry, 8 means double.
+    bool triangular;
+    std::vector<unsigned char> data;
+    [[nodiscard]] std::size_t slot(int source, int target) const;
+
+public:
+    DistanceMatrix();
+    explicit DistanceMatrix(const Graph& graph);
+    explicit DistanceMatrix(const std::string& fileName);
+    ~DistanceMatrix();
+    [[nodiscard]] int getNodeCount() const;
+    [[nodiscard]] int getWidth() const;
+    [[nodiscard]] bool isTriangular() const;
+    [[nodiscard]] std::size_t memoryUsage() const;
+    [[nodiscard]] double at(int source, int target) const;
+    bool save(const std::string& fileName) const;
+};
+
+#endif // GRAPHENGINE_DISTMATRIX_H
@@ -0,0 +1,40 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_EDGEFILE_H
+#define GRAPHENGINE_EDGEFILE_H
+
+#include <string>
+
+#include "Graph.h"
+
+/* Writes a graph larger than memory as a sorted binary edge file. Edges are buffered up to `memoryEdges`, every full
+ * buffer is sorted and spilled as a run next to the target, and `finish` merges all runs into the target. Undirected
+ * edges are kept once as (smaller, larger), repeated edges merge by adding their weights like `addEdges`. */
+class EdgeFileWriter {
+private:
+    struct Record {
+        int left, right;
+        double weight;
+    };
+    std::string fileName;
+    std::size_t memoryEdges;
+    int nodeCount;
+    bool directed, failed;
+    std::vector<Record> buffer;
+    std::vector<std::string> runs;
+    bool spill();
+
+public:
+    explicit EdgeFileWriter(std::string fileName, std::size_t memoryEdges = 1 << 24);
+    ~EdgeFileWriter();
+    void setNodeCount(int count, bool isDirected = false);
+    [[nodiscard]] int getNodeCount() const;
+    void add(const std::vector<std::tuple<int, int, double>>& edges);
+    long long finish();
+};
+
+Graph readEdgeFile(const std::string& fileName);
+
+#endif // GRAPHENGINE_EDGEFILE_H
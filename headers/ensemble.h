@@ -0,0 +1,23 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_ENSEMBLE_H
+#define GRAPHENGINE_ENSEMBLE_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "Graph.h"
+
+struct EnsembleRow {
+    std::string statistic;
+    int key; // Degree of a `degreeDistribution` row, -1 for the others.
+    long long count;
+    double mean, variance, lower, upper; // [lower, upper] is the 95% confidence interval of the mean.
+};
+
+std::vector<EnsembleRow> ensemble(const std::function<Graph()>& generate, std::uint64_t firstSeed, int seedCount, const std::vector<std::string>& statistics, const std::string& fileName = "");
+
+#endif // GRAPHENGINE_ENSEMBLE_H
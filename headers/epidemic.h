@@ -0,0 +1,24 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_EPIDEMIC_H
+#define GRAPHENGINE_EPIDEMIC_H
+
+#include <string>
+
+#include "Graph.h"
+
+struct EpidemicResult {
+    std::vector<int> outbreakSize; // Nodes ever infected in every realization.
+    std::vector<double> infected, recovered; // Average count at every step, a finished realization keeps its last state.
+};
+
+/* Discrete-time spreading along the edges (out-edges for directed graph), edge weights are ignored.
+ * "sir": every step each infected node infects each susceptible neighbor with `infectRate`, then recovers with `recoverRate`.
+ * "sis": the same, but recovered nodes are susceptible again.
+ * "ic": independent cascade, every newly activated node has one chance with `infectRate` on each neighbor.
+ * Empty `seeds` starts every realization from one random node. */
+EpidemicResult simulate(const Graph& graph, const std::string& model, double infectRate, double recoverRate = 1., const std::vector<int>& seeds = {}, int realizations = 1, int maxSteps = 1000);
+
+#endif // GRAPHENGINE_EPIDEMIC_H
@@ -5,18 +5,29 @@
 #ifndef GRAPHENGINE_GENERATOR_H
 #define GRAPHENGINE_GENERATOR_H
 
-#include <random>
-
 #include "Graph.h"
-
-static std::mt19937 gen; // Seed can be set by user.
+#include "edgefile.h"
+#include "rng.h"
 
 Graph fullConnect(int nodeCount);
 Graph lattice(int size, int dim = 2);
 Graph ring(int nodeCount, int degree = 4);
 Graph oddRegular(int nodeCount, int degree = 3);
 Graph erRandom(int nodeCount, int averageDegree, double connectRate, bool isRegular = false);
+Graph erRandom(int nodeCount, double connectRate);
 void wsSmallWorld(Graph& graph, double reconnectRate);
 Graph baScaleFree(int nodeCount, int averageDegree);
+Graph rmat(int scale, int edgeFactor = 16, double a = .57, double b = .19, double c = .19);
+Graph configurationModel(const std::vector<int>& degrees);
+std::vector<int> degreeSequence(int nodeCount, const std::vector<double>& distribution);
+
+/* Streaming versions for graphs larger than memory: edges go to `file` (see edgefile.h) with bounded memory, and the
+ * number of edges written is returned, -1 on failure. The same seed gives the same graph as in memory. */
+long long fullConnect(EdgeFileWriter& file, int nodeCount);
+long long lattice(EdgeFileWriter& file, int size, int dim = 2);
+long long ring(EdgeFileWriter& file, int nodeCount, int degree = 4);
+long long oddRegular(EdgeFileWriter& file, int nodeCount, int degree = 3);
+long long erRandom(EdgeFileWriter& file, int nodeCount, double connectRate);
+long long rmat(EdgeFileWriter& file, int scale, int edgeFactor = 16, double a = .57, double b = .19, double c = .19);
 
 #endif // GRAPHENGINE_GENERATOR_H
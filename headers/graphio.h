@@ -0,0 +1,92 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_GRAPHIO_H
+#define GRAPHENGINE_GRAPHIO_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "Graph.h"
+
+/* Read-only memory mapping of a whole file, `data` is null for an empty file. */
+class MappedFile {
+private:
+    const char* begin;
+    std::size_t length;
+    bool opened;
+#ifdef _WIN32
+    void* file;
+    void* mapping;
+#else
+    int descriptor;
+#endif
+
+public:
+    explicit MappedFile(const std::string& fileName);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    [[nodiscard]] bool isOpen() const;
+    [[nodiscard]] const char* data() const;
+    [[nodiscard]] std::size_t size() const;
+};
+
+/* The `import` csv: a "nodeCount,edgeCount,isDirected" line, then one "startNode,endNode,edgeWeight" line per edge.
+ * The file is mapped and cut at line ends into one chunk per thread, malformed lines are reported by line number
+ * and skipped. An empty graph is returned when the file or its first line cannot be read. */
+Graph readCsv(const std::string& fileName);
+/* The same csv through a pipeline: one thread reads `blockSize` blocks of whole lines, the others parse them, and the
+ * calling thread collects the edges meanwhile, linked by bounded lock-free rings. Memory beyond the edge list stays at
+ * a few blocks per thread, and the file does not need to be mappable. */
+Graph streamCsv(const std::string& fileName, std::size_t blockSize = 1 << 22);
+
+/* Standard formats of public datasets, parsed the same way in parallel chunks and built at once. A SNAP edge list has
+ * "fromNode toNode [weight]" lines and '#' comments, it is directed unless a leading comment says "Undirected", and an
+ * undirected edge listed from both ends is kept once. Ids without a 0 are 1-based (logged), ids spread over more than
+ * twice the used ones are renumbered densely. */
+Graph readSnap(const std::string& fileName);
+/* A Matrix Market coordinate matrix (".mtx") of real, integer or pattern entries. The node count is the larger side,
+ * a symmetric matrix is an undirected graph and a general one a directed graph. */
+Graph readMatrixMarket(const std::string& fileName);
+/* A METIS graph: a "nodeCount edgeCount [format [constraints]]" header and then the neighbor list of every node,
+ * 1-based. Node sizes and weights are skipped, edge weights are kept. */
+Graph readMetis(const std::string& fileName);
+
+/* Read-only graph straight over a mapped binary graph file (".geg", see `saveBinary`), nothing is parsed or copied,
+ * opening only checks that the row offsets ascend. `verify` checks the checksum and every neighbor id too, it reads
+ * the whole file once. Neighbors of a node are sorted, weights are empty when every weight is 1. */
+class GraphView {
+private:
+    std::shared_ptr<const MappedFile> file;
+    bool directed, weighted;
+    int nodeCount, edgeCount;
+    const std::uint64_t* offset;
+    const int* target;
+    const double* weight;
+
+public:
+    GraphView();
+    explicit GraphView(const std::string& fileName, bool verify = false);
+    [[nodiscard]] bool isDirected() const;
+    [[nodiscard]] bool isWeighted() const;
+    [[nodiscard]] int getNodeCount() const;
+    [[nodiscard]] int getEdgeCount() const;
+    [[nodiscard]] std::span<const int> getNeighbors(int nodeIndex) const;
+    [[nodiscard]] std::span<const double> getWeights(int nodeIndex) const;
+    [[nodiscard]] Graph toGraph() const;
+};
+
+/* Versioned little-endian layout: a 64-byte header (magic, version, flags, counts, checksum), then the CSR offsets
+ * (n + 1 of 8 bytes), the neighbor ids (4 bytes each, padded to 8) and the weights if any is not 1. */
+bool saveBinary(const Graph& graph, const std::string& fileName);
+
+/* The two `exportg` csv files. Rows are formatted on all threads and written in order with large writes, every node
+ * row is computed by one shortest path search right before it is written. Numbers use the shortest exact form. */
+bool exportNodes(const Graph& graph, const std::string& fileName);
+bool exportEdges(const Graph& graph, const std::string& fileName);
+
+#endif // GRAPHENGINE_GRAPHIO_H
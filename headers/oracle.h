@@ -0,0 +1,30 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_ORACLE_H
+#define GRAPHENGINE_ORACLE_H
+
+#include <string>
+
+#include "Graph.h"
+
+class DistanceOracle {
+private:
+    int nodeCount;
+    std::vector<std::size_t> labelOffset;
+    std::vector<int> labelHub, labelDistance; // Hubs are landmark ranks, ascending inside every label.
+
+public:
+    DistanceOracle();
+    explicit DistanceOracle(const Graph& graph);
+    explicit DistanceOracle(const std::string& fileName);
+    ~DistanceOracle();
+    [[nodiscard]] int getNodeCount() const;
+    [[nodiscard]] std::size_t getLabelCount() const;
+    [[nodiscard]] std::size_t memoryUsage() const;
+    [[nodiscard]] int query(int source, int target) const;
+    bool save(const std::string& fileName) const;
+};
+
+#endif // GRAPHENGINE_ORACLE_H
@@ -0,0 +1,170 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_PARALLEL_H
+#define GRAPHENGINE_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+int threadCount();
+void setThreadCount(int count);
+std::vector<int> balancedPartition(const std::vector<std::size_t>& offsets, int parts);
+
+/* While alive, the current thread counts as one worker: `threadCount` gives 1, so nested parallel calls run inline
+ * instead of multiplying the threads. Every worker of `runWorkers` holds one. */
+class WorkerScope {
+private:
+    bool previous;
+
+public:
+    WorkerScope();
+    ~WorkerScope();
+    WorkerScope(const WorkerScope&) = delete;
+    WorkerScope& operator=(const WorkerScope&) = delete;
+};
+
+template <typename Worker>
+void runWorkers(const int count, Worker&& worker) {
+    if (count <= 1) {
+        worker(0); // Nothing to share, keep nested calls parallel.
+        return;
+    }
+    std::vector<std::jthread> workers;
+    workers.reserve(count - 1);
+    for (int t = 1; t < count; ++t) {
+        workers.emplace_back([&worker, t]() {
+            WorkerScope scope;
+            worker(t);
+        });
+    }
+    WorkerScope scope;
+    worker(0); // The calling thread is always the zeroth worker.
+}
+
+template <typename Function>
+void parallelFor(const int begin, const int end, Function&& function) {
+    if (end <= begin) {
+        return;
+    }
+    const int count = std::min(threadCount(), end - begin);
+    runWorkers(count, [&](const int t) {
+        const long long span = end - begin;
+        function(begin + static_cast<int>(span * t / count), begin + static_cast<int>(span * (t+1) / count), t);
+    });
+}
+
+/* Bounded multi-producer multi-consumer ring without locks (Vyukov): every slot carries a sequence number, so a push
+ * or a pop only races on one index. Blocking `push` and `pop` sleep while the ring is full or empty, which is the
+ * backpressure between pipeline stages; `pop` fails once the ring is closed and drained. */
+template <typename Item>
+class BoundedQueue {
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        Item item;
+    };
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> pushIndex;
+    alignas(64) std::atomic<std::size_t> popIndex;
+    std::atomic<bool> closed;
+    std::atomic<std::uint32_t> changes; // Bumped by every push, pop and close, a blocked thread waits for it to move.
+
+    void changed() {
+        this->changes.fetch_add(1, std::memory_order_release);
+        this->changes.notify_all(); // Does not enter the kernel while nobody waits.
+    }
+
+public:
+    explicit BoundedQueue(const std::size_t capacity) : mask(std::bit_ceil(std::max<std::size_t>(2, capacity)) - 1), pushIndex(0), popIndex(0), closed(false), changes(0) {
+        this->slots = std::make_unique<Slot[]>(this->mask + 1);
+        for (std::size_t k = 0; k <= this->mask; ++k) {
+            this->slots[k].sequence.store(k, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool tryPush(Item& item) {
+        std::size_t index = this->pushIndex.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = this->slots[index & this->mask];
+            const auto lag = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - index);
+            if (lag == 0) {
+                if (this->pushIndex.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+                    slot.item = std::move(item);
+                    slot.sequence.store(index + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // Full, the slot still holds an item of the previous lap.
+            } else {
+                index = this->pushIndex.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(Item& item) {
+        std::size_t index = this->popIndex.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = this->slots[index & this->mask];
+            const auto lag = static_cast<std::ptrdiff_t>(slot.sequence.load(std::memory_order_acquire) - (index + 1));
+            if (lag == 0) {
+                if (this->popIndex.compare_exchange_weak(index, index + 1, std::memory_order_relaxed)) {
+                    item = std::move(slot.item);
+                    slot.sequence.store(index + this->mask + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false; // Empty.
+            } else {
+                index = this->popIndex.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /* The count is read before every try, so a change after a failed try makes `wait` return at once. */
+    void push(Item item) {
+        while (true) {
+            const std::uint32_t seen = this->changes.load(std::memory_order_acquire);
+            if (this->tryPush(item)) {
+                this->changed();
+                return;
+            }
+            this->changes.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    bool pop(Item& item) {
+        while (true) {
+            const std::uint32_t seen = this->changes.load(std::memory_order_acquire);
+            if (this->tryPop(item)) {
+                this->changed();
+                return true;
+            }
+            if (this->closed.load(std::memory_order_acquire)) {
+                if (this->tryPop(item)) { // Pushed before closing, but not seen by the first try.
+                    this->changed();
+                    return true;
+                }
+                return false;
+            }
+            this->changes.wait(seen, std::memory_order_acquire);
+        }
+    }
+
+    void close() {
+        this->closed.store(true, std::memory_order_release);
+        this->changed();
+    }
+};
+
+#endif // GRAPHENGINE_PARALLEL_H
@@ -0,0 +1,19 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_PERCOLATION_H
+#define GRAPHENGINE_PERCOLATION_H
+
+#include <string>
+
+#include "Graph.h"
+
+/* Giant component size after removing the first k items of `order`, for k = 0, ..., order.size(). Items are added
+ * back in reverse order into a union-find (Newman-Ziff), so a whole curve costs about one pass over the edges.
+ * Edge direction is ignored, i.e. components are weakly connected. */
+std::vector<int> sitePercolation(const Graph& graph, const std::vector<int>& order);
+std::vector<int> bondPercolation(const Graph& graph, const std::vector<std::pair<int, int>>& order);
+std::vector<double> robustness(const Graph& graph, const std::string& strategy = "random", int repeats = 1, bool bond = false);
+
+#endif // GRAPHENGINE_PERCOLATION_H
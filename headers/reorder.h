@@ -0,0 +1,24 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_REORDER_H
+#define GRAPHENGINE_REORDER_H
+
+#include <string>
+
+#include "Graph.h"
+
+/* Node orders for cache locality, `order[k]` is the original id of new node k. `method` is one of
+ * - rcm: reverse Cuthill-McKee, a breadth-first order per component from a peripheral node, so rows stay banded;
+ * - degree: degree-descending, ties in id order;
+ * - hub: hub clustering, nodes above the mean degree first, both groups keep their id order;
+ * - gorder: Gorder-like greedy order, every next node shares the most neighbors and edges with the last `window` ones.
+ * Edge direction is ignored. An empty order is returned for an unknown method. */
+std::vector<int> nodeOrder(const Graph& graph, const std::string& method = "rcm", int window = 5);
+/* Graph with node k being `order[k]` of `graph`, written in one parallel pass. `order` must be a permutation. */
+Graph permute(const Graph& graph, const std::vector<int>& order);
+/* `nodeOrder` and `permute` at once, with the order to report results in original ids. */
+std::pair<Graph, std::vector<int>> reorder(const Graph& graph, const std::string& method = "rcm", int window = 5);
+
+#endif // GRAPHENGINE_REORDER_H
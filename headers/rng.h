@@ -0,0 +1,42 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_RNG_H
+#define GRAPHENGINE_RNG_H
+
+#include <cstdint>
+
+/* Counter-based random stream (Philox4x32-10). The words of stream `stream` under key `seed` are a pure function of
+ * (seed, stream, position), so work cut into streams by node or chunk id gives the same numbers on any thread. */
+class RandomStream {
+private:
+    std::uint32_t key[2], counter[4], block[4];
+    int used;
+    void refill();
+
+public:
+    using result_type = std::uint32_t;
+    explicit RandomStream(std::uint64_t seed = 5489u, std::uint64_t stream = 0);
+    void seed(std::uint64_t seed, std::uint64_t stream = 0);
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT32_MAX; }
+    result_type operator()() {
+        if (this->used == 4) {
+            this->refill();
+        }
+        return this->block[this->used++];
+    }
+    std::uint64_t next64() {
+        const std::uint64_t high = (*this)();
+        return high << 32 | (*this)();
+    }
+    double nextDouble() {
+        return static_cast<double>(this->next64() >> 11) * 0x1.0p-53; // Uniform in [0, 1).
+    }
+    std::uint64_t nextBelow(std::uint64_t bound); // Uniform in [0, bound), bound must be positive.
+};
+
+extern thread_local RandomStream gen; // Seed can be set by user, generators draw their stream keys from it. Every thread has its own.
+
+#endif // GRAPHENGINE_RNG_H
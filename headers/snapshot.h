@@ -0,0 +1,62 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_SNAPSHOT_H
+#define GRAPHENGINE_SNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "Graph.h"
+
+/* A graph that keeps being edited while analyses run on consistent versions of it. Readers pin the current version,
+ * a writer edits a copy of it (sharing every row block it does not touch) and publishes the copy as the next version.
+ * A replaced version is retired with the epoch it was replaced in, and freed once no reader pinned at or before that
+ * epoch is left (epoch-based reclamation), so pinning is a single slot write and never waits for a writer. */
+class VersionedGraph {
+private:
+    struct Version {
+        Graph graph;
+        std::uint64_t number;
+    };
+    static constexpr int readerSlots = 64;
+    std::atomic<Version*> current;
+    std::atomic<std::uint64_t> epoch;
+    mutable std::array<std::atomic<std::uint64_t>, readerSlots> pinned; // Epoch of every reader, 0 for a free slot.
+    std::mutex writer; // Guards `retired` and serializes updates.
+    std::vector<std::pair<std::uint64_t, Version*>> retired;
+    std::size_t reclaimRetired();
+
+public:
+    /* A pinned version, readable from any thread until it is destroyed. It must not outlive its VersionedGraph. */
+    class Snapshot {
+    private:
+        const VersionedGraph* owner;
+        int slot;
+        const Version* version;
+        Snapshot(const VersionedGraph* owner, int slot, const Version* version);
+        friend class VersionedGraph;
+
+    public:
+        Snapshot(Snapshot&& other) noexcept;
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot();
+        [[nodiscard]] const Graph& getGraph() const;
+        [[nodiscard]] std::uint64_t getVersion() const;
+    };
+
+    explicit VersionedGraph(Graph graph = Graph());
+    VersionedGraph(const VersionedGraph&) = delete;
+    VersionedGraph& operator=(const VersionedGraph&) = delete;
+    ~VersionedGraph();
+    [[nodiscard]] Snapshot pin() const;
+    std::uint64_t update(const std::function<void(Graph&)>& edit);
+    std::size_t reclaim();
+    [[nodiscard]] std::uint64_t getVersion() const;
+};
+
+#endif // GRAPHENGINE_SNAPSHOT_H
@@ -6,9 +6,17 @@
 #define GRAPHENGINE_STATS_H
 
 #include "Graph.h"
+#include "subgraph.h"
 
 std::pair<std::pair<double, double>, std::vector<double>> degreeDistribution(const Graph& graph);
+std::pair<std::pair<double, double>, std::vector<double>> degreeDistribution(const SubgraphView& view);
 double clusterCoefficient(const Graph& graph);
+double clusterCoefficient(const SubgraphView& view);
 std::tuple<double, double, double> distance(const Graph& graph);
+std::tuple<double, double, double> distance(const SubgraphView& view);
+std::pair<int, std::vector<int>> coreNumber(const Graph& graph, bool parallel = false);
+std::pair<int, std::vector<int>> coreNumber(const SubgraphView& view, bool parallel = false);
+std::vector<int> degeneracyOrder(const Graph& graph);
+std::vector<int> degeneracyOrder(const SubgraphView& view);
 
 #endif // GRAPHENGINE_STATS_H
@@ -0,0 +1,119 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#ifndef GRAPHENGINE_SUBGRAPH_H
+#define GRAPHENGINE_SUBGRAPH_H
+
+#include <functional>
+
+#include "Graph.h"
+
+/* Filtered view over a graph, nothing is copied: a node set (all nodes by default) and an optional edge predicate
+ * `filter(from, to, weight)`. Node ids stay those of the graph, so `getNodeCount` is the id range and nodes outside the
+ * set simply have no neighbors. The predicate is called from worker threads, and should answer the same for both
+ * directions of an undirected edge. The graph must outlive the view and not change under it. */
+class SubgraphView {
+public:
+    using EdgeFilter = std::function<bool(int, int, double)>;
+
+    /* The kept neighbors of one node, skipped through the underlying list while iterating. */
+    class NeighborRange {
+    public:
+        class Iterator {
+        private:
+            const SubgraphView* view;
+            int source;
+            const std::pair<int, double>* current;
+            const std::pair<int, double>* last;
+
+            void skip() {
+                while (this->current != this->last && !this->view->keeps(this->source, *this->current)) {
+                    ++this->current;
+                }
+            }
+
+        public:
+            Iterator(const SubgraphView* view, const int source, const std::pair<int, double>* current, const std::pair<int, double>* last) : view(view), source(source), current(current), last(last) {
+                this->skip();
+            }
+
+            const std::pair<int, double>& operator*() const {
+                return *this->current;
+            }
+
+            Iterator& operator++() {
+                ++this->current;
+                this->skip();
+                return *this;
+            }
+
+            bool operator==(const Iterator& other) const {
+                return this->current == other.current;
+            }
+        };
+
+    private:
+        const SubgraphView* view;
+        int source;
+        const std::pair<int, double>* first;
+        const std::pair<int, double>* last;
+
+    public:
+        NeighborRange(const SubgraphView* view, const int source, const std::pair<int, double>* first, const std::pair<int, double>* last) : view(view), source(source), first(first), last(last) {}
+
+        [[nodiscard]] Iterator begin() const {
+            return Iterator(this->view, this->source, this->first, this->last);
+        }
+
+        [[nodiscard]] Iterator end() const {
+            return Iterator(this->view, this->source, this->last, this->last);
+        }
+
+        [[nodiscard]] std::size_t size() const; // Counts the kept neighbors, linear in the degree.
+    };
+
+private:
+    const Graph* graph;
+    std::vector<char> member; // Empty keeps every node.
+    EdgeFilter filter; // Empty keeps every edge.
+    int memberCount;
+
+public:
+    explicit SubgraphView(const Graph& graph, EdgeFilter filter = {});
+    SubgraphView(const Graph& graph, const std::vector<int>& nodes, EdgeFilter filter = {});
+    [[nodiscard]] const Graph& getGraph() const;
+    [[nodiscard]] bool isDirected() const;
+    [[nodiscard]] int getNodeCount() const;
+    [[nodiscard]] int getMemberCount() const;
+    [[nodiscard]] bool contains(int nodeIndex) const;
+    [[nodiscard]] NeighborRange getNeighbors(int nodeIndex) const;
+
+    [[nodiscard]] bool keeps(const int source, const std::pair<int, double>& edge) const {
+        return (this->member.empty() || this->member[edge.first]) && (!this->filter || this->filter(source, edge.first, edge.second));
+    }
+};
+
+/* Lets the search and stats templates take a graph or a view alike. */
+inline bool isMember(const Graph& graph, const int nodeIndex) {
+    return nodeIndex >= 0 && nodeIndex < graph.getNodeCount();
+}
+
+inline bool isMember(const SubgraphView& view, const int nodeIndex) {
+    return view.contains(nodeIndex);
+}
+
+inline int memberCount(const Graph& graph) {
+    return graph.getNodeCount();
+}
+
+inline int memberCount(const SubgraphView& view) {
+    return view.getMemberCount();
+}
+
+/* A standalone copy of the kept nodes and edges, relabeled to 0..k-1 in ascending id order, with the original id of
+ * every new node. Linear in nodes plus edges, rows are written on all threads. */
+std::pair<Graph, std::vector<int>> inducedSubgraph(const SubgraphView& view);
+std::pair<Graph, std::vector<int>> inducedSubgraph(const Graph& graph, const std::vector<int>& nodes);
+
+#endif // GRAPHENGINE_SUBGRAPH_H
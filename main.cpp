@@ -1,3 +1,4 @@
+#include <cmath>
 #include <charconv>
 #include <filesystem>
 #include <windows.h>
@@ -11,7 +12,15 @@
 #include "headers/Graph.h"
 #include "headers/algorithm.h"
 #include "headers/generator.h"
+#include "headers/edgefile.h"
+#include "headers/graphio.h"
 #include "headers/stats.h"
+#include "headers/community.h"
+#include "headers/oracle.h"
+#include "headers/distmatrix.h"
+#include "headers/ensemble.h"
+#include "headers/percolation.h"
+#include "headers/epidemic.h"
 
 enum class StrOpt {
     import,
@@ -20,6 +29,11 @@ enum class StrOpt {
     check,
     exportg,
     output,
+    pagerank,
+    oracle,
+    ensemble,
+    percolation,
+    simulate,
     nodecount,
     size,
     dim,
@@ -27,6 +41,8 @@ enum class StrOpt {
     connectrate,
     isregular,
     category,
+    initiator,
+    like,
     name,
     index,
     rename,
@@ -40,6 +56,23 @@ enum class StrOpt {
     rn,
     re,
     filename,
+    damping,
+    source,
+    warm,
+    load,
+    query,
+    seed,
+    count,
+    stats,
+    strategy,
+    repeat,
+    bond,
+    model,
+    infectrate,
+    recoverrate,
+    steps,
+    binary,
+    matrix,
     unknown
 };
 
@@ -51,6 +84,11 @@ void printHelpEdit();
 void printHelpCheck();
 void printHelpExportg();
 void printHelpOutput();
+void printHelpPagerank();
+void printHelpOracle();
+void printHelpEnsemble();
+void printHelpPercolation();
+void printHelpSimulate();
 
 int main(const int argc, char* argv[]) {
     if (argc < 2) {
@@ -92,6 +130,7 @@ int main(const int argc, char* argv[]) {
         options[commands.back()].emplace_back(option, val);
     }
     std::vector<std::pair<std::string, Graph>> graphs;
+    std::unordered_map<std::string, std::vector<double>> ranks; // Last PageRank result of every graph name, for warm start.
     for (const std::string& command: commands) {
         const std::string cmd = command.substr(0, command.find_last_of('_'));
         if (cmd.empty() || ((cmd == "help" || cmd == "?" || cmd == "h") && !options.contains(command))) {
@@ -119,6 +158,21 @@ int main(const int argc, char* argv[]) {
                     case StrOpt::output:
                         printHelpOutput();
                         break;
+                    case StrOpt::pagerank:
+                        printHelpPagerank();
+                        break;
+                    case StrOpt::oracle:
+                        printHelpOracle();
+                        break;
+                    case StrOpt::ensemble:
+                        printHelpEnsemble();
+                        break;
+                    case StrOpt::percolation:
+                        printHelpPercolation();
+                        break;
+                    case StrOpt::simulate:
+                        printHelpSimulate();
+                        break;
                     default:
                         std::cout << "Unknown option: " << option.first << "." << std::endl;
                 }
@@ -127,48 +181,76 @@ int main(const int argc, char* argv[]) {
         }
         if (cmd == "import") {
             if (!options[command].empty()) {
+                const bool verify = std::ranges::any_of(options[command], [](const std::pair<std::string, std::string>& option) {
+                    return option.first == "verify";
+                });
                 for (const std::pair<std::string, std::string>& option: options[command]) {
-                    std::ifstream file(option.first);
-                    if (!file.is_open()) {
+                    if (option.first == "verify") {
+                        continue;
+                    }
+                    if (option.first.ends_with(".edges")) {
+                        Graph graph = readEdgeFile(option.first); // Sorted binary edge file written by `newg -filename`.
+                        if (!graph.getNodeCount()) {
+                            continue;
+                        }
+                        const std::string name = option.second.empty() ? option.first.substr(0, option.first.find_last_of('.')) : option.second;
+                        graphs.emplace_back(name, std::move(graph));
+                        std::cout << "[Log]: " << name << " has imported successful." << std::endl;
+                        continue;
+                    }
+                    if (option.first.ends_with(".geg")) {
+                        const GraphView view(option.first, verify); // Mapped binary graph written by `exportg -binary`, hashed only on request.
+                        Graph graph = view.getNodeCount() ? view.toGraph() : Graph();
+                        if (!graph.getNodeCount()) {
+                            std::cout << "Import " << option.first << " failed, no node is read." << std::endl;
+                            continue;
+                        }
+                        const std::string name = option.second.empty() ? option.first.substr(0, option.first.find_last_of('.')) : option.second;
+                        graphs.emplace_back(name, std::move(graph));
+                        std::cout << "[Log]: " << name << " has imported successful." << std::endl;
+                        continue;
+                    }
+                    if (!std::filesystem::exists(option.first)) {
                         std::cout << "File " << option.first << " does not exist." << std::endl;
                         continue;
                     }
-                    int v1, v2, lines;
-                    std::string direct, line;
-                    bool isDirect = false;
-                    double weight;
-                    char comma;
-                    std::getline(file, line);
-                    std::stringstream ss(line);
-                    ss >> v1 >> comma >> v2 >> comma >> direct;
-                    lines = v2;
-                    std::ranges::transform(direct, direct.begin(), ::tolower);
-                    if (direct == "true") {
-                        isDirect = true;
-                    }
-                    Graph graph(v1, isDirect);
-                    for (int i = 0; i < lines; i++) {
-                        std::getline(file, line);
-                        ss >> v1 >> comma >> v2 >> comma >> weight;
-                        graph.addEdge({v1, v2, weight});
+                    /* Mapped and parsed on all threads, bad lines are reported by number. */
+                    Graph graph;
+                    if (option.first.ends_with(".txt") || option.first.ends_with(".snap")) {
+                        graph = readSnap(option.first);
+                    } else if (option.first.ends_with(".mtx")) {
+                        graph = readMatrixMarket(option.first);
+                    } else if (option.first.ends_with(".graph") || option.first.ends_with(".metis")) {
+                        graph = readMetis(option.first);
+                    } else if (std::filesystem::is_regular_file(option.first)) {
+                        graph = readCsv(option.first);
+                    } else {
+                        graph = streamCsv(option.first); // A pipe cannot be mapped, it is read, parsed and collected by separate threads at once.
+                    }
+                    if (!graph.getNodeCount()) {
+                        std::cout << "Import " << option.first << " failed, no node is read." << std::endl;
+                        continue;
                     }
                     std::string name = option.first.substr(0, option.first.find_last_of('.'));
                     if (!option.second.empty()) {
                         name = option.second;
                     }
-                    graphs.emplace_back(name, graph);
+                    graphs.emplace_back(name, std::move(graph));
                     std::cout << "[Log]: " << name << " has imported successful." << std::endl;
                 }
             } else {
                 std::cout << "Command " << command << " need `csv` file(s), use help -import to know more." << std::endl;
             }
+            continue;
         }
         if (cmd == "newg") {
             if (!options[command].empty()) {
                 int nodeCount = -1, size = -1, dim = -1, degree = -1;
                 double connectRate = -1.;
                 bool isRegular = false;
-                std::string category = "-1", name;
+                std::vector<double> initiator;
+                int like = -1;
+                std::string category = "-1", name, fileName;
                 for (std::pair<std::string, std::string> option: options[command]) {
                     std::string type = option.first;
                     std::from_chars_result pe{};
@@ -235,16 +317,75 @@ int main(const int argc, char* argv[]) {
                             }
                             category = option.second;
                             break;
+                        case StrOpt::initiator: {
+                            if (!initiator.empty()) {
+                                std::cout << "Initiator is not empty, it will be overwritten at " << cmd << " -" << type << "." << std::endl;
+                            }
+                            initiator.assign(3, 0.);
+                            const char* cur = option.second.data();
+                            const char* end = option.second.data() + option.second.size();
+                            for (int k = 0; k < 3; ++k) {
+                                pe = std::from_chars(cur, end, initiator[k]);
+                                if (pe.ec != std::errc() || (k < 2 && (pe.ptr == end || *pe.ptr != ','))) {
+                                    initiator.clear();
+                                    std::cout << "Invalid initiator: " << option.second << ", it needs three probabilities like 0.57,0.19,0.19." << std::endl;
+                                    break;
+                                }
+                                cur = pe.ptr + 1;
+                            }
+                            break;
+                        }
+                        case StrOpt::like:
+                            if (~like) {
+                                std::cout << "Like is not empty, " << like << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                            }
+                            pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), like);
+                            if (pe.ec != std::errc() || like < 0) {
+                                like = -1;
+                                std::cout << "Invalid like: " << option.second << "." << std::endl;
+                            }
+                            break;
                         case StrOpt::name:
                             if (!name.empty()) {
                                 std::cout << "Name is not empty, " << name << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
                             }
                             name = option.second;
                             break;
+                        case StrOpt::filename:
+                            if (!fileName.empty()) {
+                                std::cout << "File name is not empty, " << fileName << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                            }
+                            fileName = option.second;
+                            break;
                         default:
                             std::cout << "Unknown option: " << option.first << "." << std::endl;
                     }
                 }
+                if (!fileName.empty()) {
+                    /* Stream into a sorted binary edge file instead of the graph list, memory stays bounded. */
+                    EdgeFileWriter file(fileName);
+                    long long written = -2;
+                    if (category == "fc" && ~nodeCount) {
+                        written = fullConnect(file, nodeCount);
+                    } else if (category == "lattice" && ~size) {
+                        written = lattice(file, size, ~dim ? dim : 2);
+                    } else if (category == "ring" && ~nodeCount) {
+                        written = ring(file, nodeCount, ~degree ? degree : 4);
+                    } else if (category == "or" && ~nodeCount) {
+                        written = oddRegular(file, nodeCount, ~degree ? degree : 3);
+                    } else if (category == "er" && ~nodeCount && fabs(connectRate + 1.) > 1.e-12 && !isRegular) {
+                        written = erRandom(file, nodeCount, connectRate);
+                    } else if (category == "rmat" && ~size) {
+                        const int edgeFactor = ~degree ? degree : 16;
+                        written = initiator.empty() ? rmat(file, size, edgeFactor) : rmat(file, size, edgeFactor, initiator[0], initiator[1], initiator[2]);
+                    }
+                    if (written == -2) {
+                        std::cout << "Create new graph failed. Only fc, lattice, ring, or, irregular er and rmat can be streamed into a file, each with its essential options. Use help -newg to know more." << std::endl;
+                    } else if (~written) {
+                        std::cout << "[Log]: Graph of category " << category << " with " << file.getNodeCount() << " node(s) and " << written << " edge(s) streamed into " << fileName << " successful." << std::endl;
+                    }
+                    continue;
+                }
                 if (category == "-1") {
                     std::cout << "Create new graph failed. To create a specified graph, category is needed. Use help -newg to know more." << std::endl;
                 } else if (category == "fc") {
@@ -316,6 +457,37 @@ int main(const int argc, char* argv[]) {
                     }
                     graphs.emplace_back(name, baScaleFree(nodeCount, degree));
                     std::cout << "[Log]: B-A scale-free graph with " << nodeCount << " node(s), " << degree << " (average) degree(s) and named " << name << " created successful." << std::endl;
+                } else if (category == "rmat") {
+                    if (!~size) {
+                        std::cout << "Create new graph failed. To create an R-MAT graph, size (scale) is needed. Use help -newg to know more." << std::endl;
+                        continue;
+                    }
+                    const int edgeFactor = ~degree ? degree : 16;
+                    Graph graph = initiator.empty() ? rmat(size, edgeFactor) : rmat(size, edgeFactor, initiator[0], initiator[1], initiator[2]);
+                    if (!graph.getNodeCount()) {
+                        continue;
+                    }
+                    std::cout << "[Log]: R-MAT graph with " << graph.getNodeCount() << " node(s), " << graph.getEdgeCount() << " edge(s) and named " << name << " created successful." << std::endl;
+                    graphs.emplace_back(name, std::move(graph));
+                } else if (category == "cm") {
+                    if (!~like || like >= static_cast<int>(graphs.size())) {
+                        std::cout << "Create new graph failed. To create a configuration model graph, `like` is needed for an existed graph index. Use help -newg to know more." << std::endl;
+                        continue;
+                    }
+                    const Graph& origin = graphs[like].second;
+                    std::vector<int> degrees(origin.getNodeCount());
+                    for (int i = 0; i < origin.getNodeCount(); ++i) {
+                        degrees[i] = static_cast<int>(origin.getNeighbors(i).size());
+                    }
+                    if (~nodeCount) {
+                        degrees = degreeSequence(nodeCount, degreeDistribution(origin).second); // Same distribution, new size.
+                    }
+                    Graph graph = configurationModel(degrees);
+                    if (graph.getNodeCount() != static_cast<int>(degrees.size())) {
+                        continue;
+                    }
+                    std::cout << "[Log]: Configuration model graph with " << graph.getNodeCount() << " node(s) like the " << like << "th graph and named " << name << " created successful." << std::endl;
+                    graphs.emplace_back(name, std::move(graph));
                 } else {
                     std::cout << "Create new graph failed. Invalid category " << category << ". Use help -newg to know more or use help -import to import an arbitrary graph." << std::endl;
                 }
@@ -616,8 +788,614 @@ int main(const int argc, char* argv[]) {
             }
             continue;
         }
+        if (cmd == "pagerank") {
+            int index = -1;
+            double damping = .85;
+            bool warm = false;
+            std::vector<int> sources;
+            std::string fn = "-1";
+            for (const std::pair<std::string, std::string>& option: options[command]) {
+                std::string type = option.first;
+                std::from_chars_result pe{};
+                int source = -1;
+                switch (s2e(type)) {
+                    case StrOpt::index:
+                        if (~index) {
+                            std::cout << "Index is not empty, " << index << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), index);
+                        if (pe.ec != std::errc()) {
+                            index = -1;
+                            std::cout << "Invalid index: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::name: {
+                        if (~index) {
+                            std::cout << "Index is not empty, index for name " << option.second << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        auto it = std::ranges::find_if(graphs, [&option](const std::pair<std::string, Graph>& grh) {
+                            return grh.first == option.second;
+                        });
+                        if (it == graphs.end()) {
+                            index = -1;
+                            std::cout << "Cannot find graph name: " << option.second << ", index reset." << std::endl;
+                        } else {
+                            index = static_cast<int>(distance(graphs.begin(), it));
+                        }
+                        break;
+                    }
+                    case StrOpt::damping:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), damping);
+                        if (pe.ec != std::errc()) {
+                            damping = .85;
+                            std::cout << "Invalid damping factor: " << option.second << ", default value 0.85 will be used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::source:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), source);
+                        if (pe.ec != std::errc() || source < 0) {
+                            std::cout << "Invalid source node: " << option.second << "." << std::endl;
+                        } else {
+                            sources.push_back(source);
+                        }
+                        break;
+                    case StrOpt::warm:
+                        warm = true;
+                        break;
+                    case StrOpt::filename:
+                        if (fn.ends_with(".csv")) {
+                            std::cout << "Filename is not empty, " << fn << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        if (option.second.ends_with(".csv")) {
+                            fn = option.second;
+                        } else {
+                            fn = option.second + ".csv";
+                        }
+                        break;
+                    default:
+                        std::cout << "Unknown option " << type << "." << std::endl;
+                }
+            }
+            if (std::ranges::none_of(options[command], [](const std::pair<std::string, std::string>& option) {
+                return s2e(option.first) == StrOpt::index || s2e(option.first) == StrOpt::name;
+            })) {
+                index = 0;
+            }
+            if (!~index || index >= static_cast<int>(graphs.size())) {
+                std::cout << "Invalid index " << index << " in current graph list." << std::endl;
+                continue;
+            }
+            const Graph& graph = graphs[index].second;
+            std::vector<double> personalization;
+            if (!sources.empty()) {
+                personalization.assign(graph.getNodeCount(), 0.);
+                for (const int source: sources) {
+                    if (source >= graph.getNodeCount()) {
+                        std::cout << "Source node " << source << " is not in this graph with " << graph.getNodeCount() << " node(s), ignored." << std::endl;
+                        continue;
+                    }
+                    personalization[source] = 1.;
+                }
+            }
+            std::vector<double> initial;
+            if (warm) {
+                if (ranks.contains(graphs[index].first)) {
+                    initial = ranks[graphs[index].first];
+                } else {
+                    std::cout << "No previous PageRank of graph named " << graphs[index].first << ", warm start ignored." << std::endl;
+                }
+            }
+            std::vector<double> rank = pageRank(graph, damping, personalization, initial);
+            if (rank.empty()) {
+                std::cout << "PageRank failed on the " << index << "th graph named " << graphs[index].first << "." << std::endl;
+                continue;
+            }
+            ranks[graphs[index].first] = rank;
+            if (fn == "-1") {
+                fn = "pagerank.csv";
+            }
+            std::filesystem::path path = fn;
+            int suffix = 0;
+            while (std::filesystem::exists(fn)) {
+                fn = path.stem().string() + std::to_string(suffix++) + path.extension().string();
+            }
+            std::ofstream ofs(fn);
+            ofs << "nodeIndex,pageRank\n";
+            for (int i = 0; i < graph.getNodeCount(); ++i) {
+                ofs << i << ',' << rank[i] << '\n';
+            }
+            ofs.close();
+            std::cout << "[Log]: PageRank of the " << index << "th graph named " << graphs[index].first << " with " << damping << " damping factor" << (personalization.empty() ? "" : " (personalized)") << " exported successful at " << fn << "." << std::endl;
+            continue;
+        }
+        if (cmd == "oracle") {
+            int index = -1;
+            std::string fn = "-1", load;
+            std::vector<std::pair<int, int>> queries;
+            for (const std::pair<std::string, std::string>& option: options[command]) {
+                std::string type = option.first;
+                std::from_chars_result pe{};
+                int v1 = -1, v2 = -1;
+                switch (s2e(type)) {
+                    case StrOpt::index:
+                        if (~index) {
+                            std::cout << "Index is not empty, " << index << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), index);
+                        if (pe.ec != std::errc()) {
+                            index = -1;
+                            std::cout << "Invalid index: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::name: {
+                        if (~index) {
+                            std::cout << "Index is not empty, index for name " << option.second << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        auto it = std::ranges::find_if(graphs, [&option](const std::pair<std::string, Graph>& grh) {
+                            return grh.first == option.second;
+                        });
+                        if (it == graphs.end()) {
+                            index = -1;
+                            std::cout << "Cannot find graph name: " << option.second << ", index reset." << std::endl;
+                        } else {
+                            index = static_cast<int>(distance(graphs.begin(), it));
+                        }
+                        break;
+                    }
+                    case StrOpt::load:
+                        if (!load.empty()) {
+                            std::cout << "Load file is not empty, " << load << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        load = option.second;
+                        break;
+                    case StrOpt::query:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), v1);
+                        if (pe.ec == std::errc() && pe.ptr != option.second.data() + option.second.size()) {
+                            pe = std::from_chars(++pe.ptr, option.second.data() + option.second.size(), v2);
+                        }
+                        if (pe.ec != std::errc() || v1 < 0 || v2 < 0) {
+                            std::cout << "Invalid query node pair: " << option.second << "." << std::endl;
+                        } else {
+                            queries.emplace_back(v1, v2);
+                        }
+                        break;
+                    case StrOpt::filename:
+                        if (fn.ends_with(".pll")) {
+                            std::cout << "Filename is not empty, " << fn << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        if (option.second.ends_with(".pll")) {
+                            fn = option.second;
+                        } else {
+                            fn = option.second + ".pll";
+                        }
+                        break;
+                    default:
+                        std::cout << "Unknown option " << type << "." << std::endl;
+                }
+            }
+            DistanceOracle oracle;
+            if (!load.empty()) {
+                oracle = DistanceOracle(load);
+                std::cout << "[Log]: Distance oracle loaded from " << load << " with " << oracle.getNodeCount() << " node(s) and " << oracle.getLabelCount() << " label(s), " << oracle.memoryUsage() << " byte(s) in memory." << std::endl;
+            } else {
+                if (std::ranges::none_of(options[command], [](const std::pair<std::string, std::string>& option) {
+                    return s2e(option.first) == StrOpt::index || s2e(option.first) == StrOpt::name;
+                })) {
+                    index = 0;
+                }
+                if (!~index || index >= static_cast<int>(graphs.size())) {
+                    std::cout << "Invalid index " << index << " in current graph list." << std::endl;
+                    continue;
+                }
+                oracle = DistanceOracle(graphs[index].second);
+                if (fn == "-1") {
+                    fn = "oracle.pll";
+                }
+                std::filesystem::path path = fn;
+                int suffix = 0;
+                while (std::filesystem::exists(fn)) {
+                    fn = path.stem().string() + std::to_string(suffix++) + path.extension().string();
+                }
+                if (oracle.save(fn)) {
+                    std::cout << "[Log]: Distance oracle of the " << index << "th graph named " << graphs[index].first << " built with " << oracle.getLabelCount() << " label(s), " << oracle.memoryUsage() << " byte(s) in memory, saved at " << fn << "." << std::endl;
+                }
+            }
+            for (const auto& [v1, v2]: queries) {
+                if (v1 >= oracle.getNodeCount() || v2 >= oracle.getNodeCount()) {
+                    std::cout << "Query [" << v1 << ", " << v2 << "] is out of the oracle with " << oracle.getNodeCount() << " node(s)." << std::endl;
+                    continue;
+                }
+                const int hop = oracle.query(v1, v2);
+                if (~hop) {
+                    std::cout << "Distance between " << v1 << " and " << v2 << " is " << hop << " hop(s)." << std::endl;
+                } else {
+                    std::cout << "Node " << v2 << " cannot be reached from " << v1 << "." << std::endl;
+                }
+            }
+            continue;
+        }
+        if (cmd == "ensemble") {
+            int nodeCount = -1, size = -1, degree = -1, count = 32;
+            long long seed = 1;
+            double connectRate = -1.;
+            bool isRegular = false;
+            std::vector<double> initiator;
+            std::vector<std::string> statistics;
+            std::string category = "-1", fn = "-1";
+            for (const std::pair<std::string, std::string>& option: options[command]) {
+                std::string type = option.first;
+                std::from_chars_result pe{};
+                switch (s2e(type)) {
+                    case StrOpt::category:
+                        category = option.second;
+                        break;
+                    case StrOpt::nodecount:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), nodeCount);
+                        if (pe.ec != std::errc()) {
+                            nodeCount = -1;
+                            std::cout << "Invalid node count: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::size:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), size);
+                        if (pe.ec != std::errc()) {
+                            size = -1;
+                            std::cout << "Invalid size: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::degree:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), degree);
+                        if (pe.ec != std::errc()) {
+                            degree = -1;
+                            std::cout << "Invalid degree: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::connectrate:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), connectRate);
+                        if (pe.ec != std::errc()) {
+                            connectRate = -1.;
+                            std::cout << "Invalid connectrate: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::isregular:
+                        isRegular = (option.second == "true");
+                        break;
+                    case StrOpt::initiator: {
+                        initiator.assign(3, 0.);
+                        const char* cur = option.second.data();
+                        const char* end = option.second.data() + option.second.size();
+                        for (int k = 0; k < 3; ++k) {
+                            pe = std::from_chars(cur, end, initiator[k]);
+                            if (pe.ec != std::errc() || (k < 2 && (pe.ptr == end || *pe.ptr != ','))) {
+                                initiator.clear();
+                                std::cout << "Invalid initiator: " << option.second << ", it needs three probabilities like 0.57,0.19,0.19." << std::endl;
+                                break;
+                            }
+                            cur = pe.ptr + 1;
+                        }
+                        break;
+                    }
+                    case StrOpt::seed:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), seed);
+                        if (pe.ec != std::errc() || seed < 0) {
+                            seed = 1;
+                            std::cout << "Invalid seed: " << option.second << ", default value 1 is used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::count:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), count);
+                        if (pe.ec != std::errc() || count <= 0) {
+                            count = 32;
+                            std::cout << "Invalid count: " << option.second << ", default value 32 is used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::stats: {
+                        statistics.clear();
+                        std::stringstream ss(option.second);
+                        std::string statistic;
+                        while (std::getline(ss, statistic, ',')) {
+                            if (!statistic.empty()) {
+                                statistics.push_back(statistic);
+                            }
+                        }
+                        break;
+                    }
+                    case StrOpt::filename:
+                        if (fn.ends_with(".csv")) {
+                            std::cout << "Filename is not empty, " << fn << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        if (option.second.ends_with(".csv")) {
+                            fn = option.second;
+                        } else {
+                            fn = option.second + ".csv";
+                        }
+                        break;
+                    default:
+                        std::cout << "Unknown option " << type << "." << std::endl;
+                }
+            }
+            std::function<Graph()> generate;
+            if (category == "er" && ~nodeCount && ~degree && connectRate >= 0.) {
+                if (isRegular) {
+                    generate = [=]() { return erRandom(nodeCount, degree, connectRate, true); };
+                } else {
+                    std::cout << "Arg `averageDegree` is not effective for irregular Erdös-Rényi random network." << std::endl; // Once, not per seed.
+                    generate = [=]() { return erRandom(nodeCount, connectRate); };
+                }
+            } else if (category == "basf" && ~nodeCount && ~degree) {
+                generate = [=]() { return baScaleFree(nodeCount, degree); };
+            } else if (category == "ws" && ~nodeCount && connectRate >= 0.) {
+                generate = [=]() {
+                    Graph graph = ring(nodeCount, ~degree ? degree : 4);
+                    wsSmallWorld(graph, connectRate);
+                    return graph;
+                };
+            } else if (category == "rmat" && ~size) {
+                const int edgeFactor = ~degree ? degree : 16;
+                generate = [=]() { return initiator.empty() ? rmat(size, edgeFactor) : rmat(size, edgeFactor, initiator[0], initiator[1], initiator[2]); };
+            } else {
+                std::cout << "Ensemble failed. Only er, basf, ws and rmat are supported, each with its essential options. Use help -ensemble to know more." << std::endl;
+                continue;
+            }
+            if (statistics.empty()) {
+                statistics = {"size", "degree", "cluster"};
+            }
+            if (fn == "-1") {
+                fn = "ensemble.csv";
+            }
+            std::filesystem::path path = fn;
+            int suffix = 0;
+            while (std::filesystem::exists(fn)) {
+                fn = path.stem().string() + std::to_string(suffix++) + path.extension().string();
+            }
+            const std::vector<EnsembleRow> rows = ensemble(generate, seed, count, statistics, fn);
+            if (rows.empty()) {
+                continue;
+            }
+            for (const EnsembleRow& row: rows) {
+                if (!~row.key) {
+                    std::cout << row.statistic << ": " << row.mean << " in [" << row.lower << ", " << row.upper << "]." << std::endl;
+                }
+            }
+            std::cout << "[Log]: Ensemble of " << count << " " << category << " graph(s) from seed " << seed << " exported successful at " << fn << "." << std::endl;
+            continue;
+        }
+        if (cmd == "percolation") {
+            int index = -1, repeats = 1;
+            bool bond = false;
+            std::string fn = "-1", strategy = "random";
+            for (const std::pair<std::string, std::string>& option: options[command]) {
+                std::string type = option.first;
+                std::from_chars_result pe{};
+                switch (s2e(type)) {
+                    case StrOpt::index:
+                        if (~index) {
+                            std::cout << "Index is not empty, " << index << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), index);
+                        if (pe.ec != std::errc()) {
+                            index = -1;
+                            std::cout << "Invalid index: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::name: {
+                        if (~index) {
+                            std::cout << "Index is not empty, index for name " << option.second << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        auto it = std::ranges::find_if(graphs, [&option](const std::pair<std::string, Graph>& grh) {
+                            return grh.first == option.second;
+                        });
+                        if (it == graphs.end()) {
+                            index = -1;
+                            std::cout << "Cannot find graph name: " << option.second << ", index reset." << std::endl;
+                        } else {
+                            index = static_cast<int>(distance(graphs.begin(), it));
+                        }
+                        break;
+                    }
+                    case StrOpt::strategy:
+                        if (option.second != "random" && option.second != "degree") {
+                            strategy = "random";
+                            std::cout << "Invalid strategy: " << option.second << ", only random and degree are supported, default value random is used." << std::endl;
+                        } else {
+                            strategy = option.second;
+                        }
+                        break;
+                    case StrOpt::repeat:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), repeats);
+                        if (pe.ec != std::errc() || repeats <= 0) {
+                            repeats = 1;
+                            std::cout << "Invalid repeat: " << option.second << ", default value 1 is used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::bond:
+                        bond = true;
+                        break;
+                    case StrOpt::filename:
+                        if (fn.ends_with(".csv")) {
+                            std::cout << "Filename is not empty, " << fn << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        if (option.second.ends_with(".csv")) {
+                            fn = option.second;
+                        } else {
+                            fn = option.second + ".csv";
+                        }
+                        break;
+                    default:
+                        std::cout << "Unknown option " << type << "." << std::endl;
+                }
+            }
+            if (std::ranges::none_of(options[command], [](const std::pair<std::string, std::string>& option) {
+                return s2e(option.first) == StrOpt::index || s2e(option.first) == StrOpt::name;
+            })) {
+                index = 0;
+            }
+            if (!~index || index >= static_cast<int>(graphs.size())) {
+                std::cout << "Invalid index " << index << " in current graph list." << std::endl;
+                continue;
+            }
+            const std::vector<double> curve = robustness(graphs[index].second, strategy, repeats, bond);
+            if (curve.empty()) {
+                continue;
+            }
+            if (fn == "-1") {
+                fn = "percolation.csv";
+            }
+            std::filesystem::path path = fn;
+            int suffix = 0;
+            while (std::filesystem::exists(fn)) {
+                fn = path.stem().string() + std::to_string(suffix++) + path.extension().string();
+            }
+            std::ofstream ofs(fn);
+            ofs << "removed,giant" << std::endl;
+            double area = 0.;
+            for (std::size_t k = 0; k < curve.size(); ++k) {
+                ofs << k << ',' << curve[k] << '\n';
+                area += k ? curve[k] : 0.;
+            }
+            ofs.close();
+            std::cout << "[Log]: " << (bond ? "Bond" : "Site") << " percolation of the " << index << "th graph named " << graphs[index].first << " under " << strategy << " removal has robustness " << (curve.size() > 1 ? area / static_cast<double>(curve.size() - 1) : 0.) << ", exported successful at " << fn << "." << std::endl;
+            continue;
+        }
+        if (cmd == "simulate") {
+            int index = -1, repeats = 1, steps = 1000, source = -1;
+            double infectRate = -1., recoverRate = 1.;
+            std::vector<int> sources;
+            std::string fn = "-1", model = "sir";
+            for (const std::pair<std::string, std::string>& option: options[command]) {
+                std::string type = option.first;
+                std::from_chars_result pe{};
+                switch (s2e(type)) {
+                    case StrOpt::index:
+                        if (~index) {
+                            std::cout << "Index is not empty, " << index << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), index);
+                        if (pe.ec != std::errc()) {
+                            index = -1;
+                            std::cout << "Invalid index: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::name: {
+                        if (~index) {
+                            std::cout << "Index is not empty, index for name " << option.second << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        auto it = std::ranges::find_if(graphs, [&option](const std::pair<std::string, Graph>& grh) {
+                            return grh.first == option.second;
+                        });
+                        if (it == graphs.end()) {
+                            index = -1;
+                            std::cout << "Cannot find graph name: " << option.second << ", index reset." << std::endl;
+                        } else {
+                            index = static_cast<int>(distance(graphs.begin(), it));
+                        }
+                        break;
+                    }
+                    case StrOpt::model:
+                        model = option.second;
+                        break;
+                    case StrOpt::infectrate:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), infectRate);
+                        if (pe.ec != std::errc()) {
+                            infectRate = -1.;
+                            std::cout << "Invalid infectrate: " << option.second << "." << std::endl;
+                        }
+                        break;
+                    case StrOpt::recoverrate:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), recoverRate);
+                        if (pe.ec != std::errc()) {
+                            recoverRate = 1.;
+                            std::cout << "Invalid recoverrate: " << option.second << ", default value 1 is used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::source:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), source);
+                        if (pe.ec != std::errc() || source < 0) {
+                            std::cout << "Invalid source node: " << option.second << "." << std::endl;
+                        } else {
+                            sources.push_back(source);
+                        }
+                        break;
+                    case StrOpt::repeat:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), repeats);
+                        if (pe.ec != std::errc() || repeats <= 0) {
+                            repeats = 1;
+                            std::cout << "Invalid repeat: " << option.second << ", default value 1 is used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::steps:
+                        pe = std::from_chars(option.second.data(), option.second.data() + option.second.size(), steps);
+                        if (pe.ec != std::errc() || steps <= 0) {
+                            steps = 1000;
+                            std::cout << "Invalid steps: " << option.second << ", default value 1000 is used." << std::endl;
+                        }
+                        break;
+                    case StrOpt::filename:
+                        if (fn.ends_with(".csv")) {
+                            std::cout << "Filename is not empty, " << fn << " at " << cmd << " -" << type << " will be overwritten." << std::endl;
+                        }
+                        if (option.second.ends_with(".csv")) {
+                            fn = option.second;
+                        } else {
+                            fn = option.second + ".csv";
+                        }
+                        break;
+                    default:
+                        std::cout << "Unknown option " << type << "." << std::endl;
+                }
+            }
+            if (std::ranges::none_of(options[command], [](const std::pair<std::string, std::string>& option) {
+                return s2e(option.first) == StrOpt::index || s2e(option.first) == StrOpt::name;
+            })) {
+                index = 0;
+            }
+            if (!~index || index >= static_cast<int>(graphs.size())) {
+                std::cout << "Invalid index " << index << " in current graph list." << std::endl;
+                continue;
+            }
+            if (infectRate < 0.) {
+                std::cout << "Simulation failed. To spread on a graph, infect rate is needed. Use help -simulate to know more." << std::endl;
+                continue;
+            }
+            const EpidemicResult result = simulate(graphs[index].second, model, infectRate, recoverRate, sources, repeats, steps);
+            if (result.outbreakSize.empty()) {
+                continue;
+            }
+            if (fn == "-1") {
+                fn = "simulate.csv";
+            }
+            std::string cfn = "curve_" + fn, ofn = "outbreak_" + fn;
+            std::filesystem::path pathC = cfn, pathO = ofn;
+            int suffix = 0;
+            while (std::filesystem::exists(cfn) || std::filesystem::exists(ofn)) {
+                cfn = pathC.stem().string() + std::to_string(suffix) + pathC.extension().string();
+                ofn = pathO.stem().string() + std::to_string(suffix) + pathO.extension().string();
+                suffix++;
+            }
+            std::ofstream ofs(cfn);
+            ofs << "step,infected,recovered" << std::endl;
+            for (std::size_t s = 0; s < result.infected.size(); ++s) {
+                ofs << s << ',' << result.infected[s] << ',' << result.recovered[s] << '\n';
+            }
+            ofs.close();
+            std::vector<int> sizes = result.outbreakSize;
+            std::ranges::sort(sizes);
+            double average = 0.;
+            ofs.open(ofn);
+            ofs << "outbreakSize,count" << std::endl;
+            for (std::size_t i = 0, j = 0; i < sizes.size(); i = j) {
+                while (j < sizes.size() && sizes[j] == sizes[i]) {
+                    average += sizes[j++];
+                }
+                ofs << sizes[i] << ',' << j - i << '\n';
+            }
+            ofs.close();
+            std::cout << "[Log]: " << repeats << " realization(s) of " << model << " on the " << index << "th graph named " << graphs[index].first << " reach " << average / repeats << " node(s) on average. Curve in " << cfn << " file, and outbreak sizes in " << ofn << " file." << std::endl;
+            continue;
+        }
         if (cmd == "exportg") {
             int index = -1;
+            bool binary = false, matrix = false;
             std::string fn = "-1";
             if (!options[command].empty()) {
                 for (const std::pair<std::string, std::string>& option: options[command]) {
@@ -659,6 +1437,12 @@ int main(const int argc, char* argv[]) {
                                 fn = option.second + ".csv";
                             }
                             break;
+                        case StrOpt::binary:
+                            binary = true;
+                            break;
+                        case StrOpt::matrix:
+                            matrix = true;
+                            break;
                         default:
                             std::cout << "Unknown option " << type << "." << std::endl;
                     }
@@ -667,6 +1451,11 @@ int main(const int argc, char* argv[]) {
                 index = 0;
                 fn = "exportg.csv";
             }
+            if (std::ranges::none_of(options[command], [](const std::pair<std::string, std::string>& option) {
+                return s2e(option.first) == StrOpt::index || s2e(option.first) == StrOpt::name;
+            })) {
+                index = 0;
+            }
             if (!~index || index >= static_cast<int>(graphs.size())) {
                 std::cout << "Invalid index " << index << " in current graph list." << std::endl;
                 continue;
@@ -674,6 +1463,32 @@ int main(const int argc, char* argv[]) {
             if (fn == "-1") {
                 fn = "exportg.csv";
             }
+            if (binary) {
+                std::string bfn = fn.substr(0, fn.size() - 4) + ".geg";
+                std::filesystem::path pathB = bfn;
+                int suffix = 0;
+                while (std::filesystem::exists(bfn)) {
+                    bfn = pathB.stem().string() + std::to_string(suffix++) + pathB.extension().string();
+                }
+                if (saveBinary(graphs[index].second, bfn)) {
+                    std::cout << "[Log]: Exported graph index " << index << "th with " << graphs[index].first << " name successful. Binary graph in " << bfn << " file." << std::endl;
+                }
+            }
+            if (matrix) {
+                std::string mfn = "matrix_" + fn.substr(0, fn.size() - 4) + ".ged";
+                std::filesystem::path pathM = mfn;
+                int suffix = 0;
+                while (std::filesystem::exists(mfn)) {
+                    mfn = pathM.stem().string() + std::to_string(suffix++) + pathM.extension().string();
+                }
+                const DistanceMatrix distances(graphs[index].second);
+                if (distances.save(mfn)) {
+                    std::cout << "[Log]: Exported graph index " << index << "th with " << graphs[index].first << " name successful. Distance matrix (" << distances.getWidth() << " byte(s) per entry" << (distances.isTriangular() ? ", lower triangle" : "") << ") in " << mfn << " file." << std::endl;
+                }
+            }
+            if (binary || matrix) {
+                continue;
+            }
             std::string nfn = "nodes_" + fn, efn = "edges_" + fn;
             std::filesystem::path pathN = nfn, pathE = efn;
             int suffix = 0;
@@ -682,44 +1497,9 @@ int main(const int argc, char* argv[]) {
                 efn = pathE.stem().string() + std::to_string(suffix) + pathE.extension().string();
                 suffix++;
             }
-            std::ofstream ofs(nfn);
-            ofs << "nodeIndex,reachNodeCount,degreeDistribution";
-            for (int i = 0; i < graphs[index].second.getNodeCount(); i++) {
-                ofs << ",distanceTo" << i << "thNode";
-            }
-            ofs << std::endl;
-            std::pair<std::pair<double, double>, std::vector<double>> dgrDist = degreeDistribution(graphs[index].second);
-            std::vector<int> reach(graphs[index].second.getNodeCount(), 0);
-            for (int i = 0; i < graphs[index].second.getNodeCount(); i++) {
-                for (int j = 0; j < graphs[index].second.getNodeCount(); j++) {
-                    if (i == j) {
-                        continue;
-                    }
-                    reach[i] += bfs(graphs[index].second, {i, j});
-                }
-            }
-            std::vector<std::vector<double>> dist = floyd(graphs[index].second);
-            for (int i = 0; i < graphs[index].second.getNodeCount(); i++) {
-                ofs << i << "," << reach[i] << "," << dgrDist.second[i];
-                for (int j = 0; j < graphs[index].second.getNodeCount(); j++) {
-                    ofs << "," << dist[i][j];
-                }
-                ofs << std::endl;
-            }
-            ofs.close();
-            ofs.open(efn);
-            int ec = graphs[index].second.getEdgeCount();
-            ofs << graphs[index].second.getNodeCount() << "," << ec << (graphs[index].second.isDirected() ? ",True" : ",False") << std::endl;
-            for (int i = 0; i < graphs[index].second.getNodeCount(); i++) {
-                int lmt = graphs[index].second.isDirected() ? graphs[index].second.getNodeCount() : i;
-                for (const auto& [nbr, wei]: graphs[index].second.getNeighbors(i)) {
-                    if (nbr >= lmt) {
-                        break;
-                    }
-                    ofs << i << "," << nbr << "," << wei << std::endl;
-                }
+            if (!exportNodes(graphs[index].second, nfn) || !exportEdges(graphs[index].second, efn)) {
+                continue;
             }
-            ofs.close();
             std::cout << "[Log]: Exported graph index " << index << "th with " << graphs[index].first << " name successful. Node information in " << nfn << " file, and edges in " << efn << " file." << std::endl;
             continue;
         }
@@ -740,13 +1520,15 @@ int main(const int argc, char* argv[]) {
                 fn = path.stem().string() + std::to_string(suffix++) + path.extension().string();
             }
             std::ofstream ofs(fn);
-            ofs << "index,name,isDirect,nodeCount,edgeCount,averageDegree,varianceDegree,clusterCoefficient,minimumDistance,averageDistance,maximumDistance" << std::endl;
+            ofs << "index,name,isDirect,nodeCount,edgeCount,averageDegree,varianceDegree,clusterCoefficient,minimumDistance,averageDistance,maximumDistance,communityCount,modularity" << std::endl;
             for (int i = 0; i < graphs.size(); ++i) {
                 ofs << i << ',' << graphs[i].first << ',' << (graphs[i].second.isDirected() ? "True," : "False,") << graphs[i].second.getNodeCount() << ',' << graphs[i].second.getEdgeCount() << ',';
                 auto [ds, dd] = degreeDistribution(graphs[i].second);
                 ofs << ds.first << ',' << ds.second << ',' << clusterCoefficient(graphs[i].second) << ',';
                 auto [min, ave, max] = distance(graphs[i].second);
-                ofs << min << ',' << ave << ',' << max << std::endl;
+                ofs << min << ',' << ave << ',' << max << ',';
+                auto [mod, com] = louvain(graphs[i].second);
+                ofs << (com.empty() ? 0 : *std::ranges::max_element(com) + 1) << ',' << mod << std::endl;
             }
             ofs.close();
             std::cout << "[Log]: Export all the graph(s) successful at " << fn << "." << std::endl;
@@ -765,16 +1547,26 @@ void printHelp() {
     std::cout << "A whole run can include a lot of continuously commands, graph will form a list with creation order by default. When all command finished, everything will be release. In other words, there is no relation or remember between running, you must key-in all your operates at once." << std::endl;
     std::cout << "Command: `import` to read \"csv\" files as edge sets, each file will be read as an single graph. Option: file name (must end with \".csv\"). Value: graph name(may empty), default for file name." << std::endl;
     std::cout << "\tUse help -import to know more." << std::endl;
-    std::cout << "Command: `newg` to create a specific new graph. Option list: {name, category, nodecount, size, dim, degree, connectrate, isregular, category}. Value: name refers to graph name(may empty), default for empty; category is essential, others are optional." << std::endl;
+    std::cout << "Command: `newg` to create a specific new graph. Option list: {name, category, nodecount, size, dim, degree, connectrate, isregular, initiator, like, filename}. Value: name refers to graph name(may empty), default for empty; category is essential, others are optional." << std::endl;
     std::cout << "\tUse help -newg to know more." << std::endl;
     std::cout << "Command: `edit` to edit existed graph\'s attributes. Option list: {index, name, rename, remove, swap, wssw, an, ans, ae, ee, rn, re}. `Index` and `name` are to locate exact graph, `rename` just as its name to rename an exist graph, others are for modify graph's structure." << std::endl;
     std::cout << "\tUse help -edit to know more." << std::endl;
     std::cout << "Command: `check` to check the connectivity of the specific graph, i.e. whether an entity can reach every node starts form zeroth node or not. Option(optional): index or name, only one option effective and it must be the former." << std::endl;
     std::cout << "\tUse help -check to know more." << std::endl;
-    std::cout << "Command: `exportg` to export specific graph\'s all node information and all the edges. Option list: {index, name, filename}, all of options are optional. `Index` and `name` are to locate exact graph, `filename` is to specify the export file name, default export the zeroth graph into nodes_exportg.csv and edges_exportg.csv." << std::endl;
+    std::cout << "Command: `exportg` to export specific graph\'s all node information and all the edges. Option list: {index, name, filename, binary, matrix}, all of options are optional. `Index` and `name` are to locate exact graph, `filename` is to specify the export file name, default export the zeroth graph into nodes_exportg.csv and edges_exportg.csv." << std::endl;
     std::cout << "\tUse help -exportg to know more." << std::endl;
     std::cout << "Command: `output` to export all the graphs\' abstract in list. Option(optional): filename, only the first optional will effective. Value: the output file name." << std::endl;
     std::cout << "\tUse help -output to know more." << std::endl;
+    std::cout << "Command: `pagerank` to calculate (personalized) PageRank of the specific graph. Option list: {index, name, damping, source, warm, filename}, all of options are optional, default calculate the zeroth graph into pagerank.csv." << std::endl;
+    std::cout << "\tUse help -pagerank to know more." << std::endl;
+    std::cout << "Command: `oracle` to build (or load) an exact hop distance index of the specific graph and answer point-to-point queries. Option list: {index, name, load, filename, query}, all of options are optional, default index the zeroth graph into oracle.pll." << std::endl;
+    std::cout << "\tUse help -oracle to know more." << std::endl;
+    std::cout << "Command: `ensemble` to generate many random graphs of one category with consecutive seeds and summarize their statistics. Option list: {category, nodecount, size, degree, connectrate, isregular, initiator, seed, count, stats, filename}, category is essential, default summarize 32 graphs into ensemble.csv." << std::endl;
+    std::cout << "\tUse help -ensemble to know more." << std::endl;
+    std::cout << "Command: `percolation` to remove nodes (or edges) of the specific graph one by one and record the giant component size after every removal. Option list: {index, name, strategy, repeat, bond, filename}, all of options are optional, default remove nodes of the zeroth graph in random order into percolation.csv." << std::endl;
+    std::cout << "\tUse help -percolation to know more." << std::endl;
+    std::cout << "Command: `simulate` to run SIR, SIS or independent cascade spreading on the specific graph many times. Option list: {index, name, model, infectrate, recoverrate, source, repeat, steps, filename}, `infectrate` is essential, default run SIR once on the zeroth graph into curve_simulate.csv and outbreak_simulate.csv." << std::endl;
+    std::cout << "\tUse help -simulate to know more." << std::endl;
     std::cout << "Other commands will be implicitly ignored." << std::endl;
     std::cout << "If an error occurs at the theoretical level, the backend interface will directly report an error. For example, if a graph with no base node degree exists, attempting to create it forcibly will result in an error." << std::endl;
     std::cout << "----------------------------------------------------------------" << std::endl;
@@ -785,19 +1577,26 @@ void printHelpImport() {
     std::cout << "For example, GraphEngine import -../myGraph.csv =g1 -./myNewGraph.csv." << std::endl;
     std::cout << "It will import two graphs append into graph list, first one will be named with \"g1\", and the second one will be use default name\"./myNewGraph\"." << std::endl;
     std::cout << "Data in `csv` file must have a head line: \"nodeCount,edgeCount,isDirected\\n\", and then it must have `edgeCount` lines remain, each line with format: \"startNode,endNode,edgeWeight\\n\". `startNode` and `endNode` must be an integer and smaller than `nodeCount`. `isDirected` must use TRUE to active, otherwise will be undirected." << std::endl;
+    std::cout << "Blanks around values and Windows line ends are allowed. A malformed line or a node out of the graph is skipped and reported with its line number. A file is mapped and parsed on all threads, input that cannot be mapped (e.g. a pipe) is read, parsed and collected at the same time on separate threads, with a few blocks of it in memory." << std::endl;
+    std::cout << "Public dataset formats are chosen by the file ending: \".txt\" or \".snap\" is a SNAP edge list (\"fromNode toNode [weight]\" lines, '#' comments, directed unless a leading comment says undirected, an edge listed from both ends of an undirected one is kept once), \".mtx\" is a Matrix Market coordinate matrix (symmetric ones are undirected) and \".graph\" or \".metis\" is a METIS adjacency file. 1-based ids become 0-based, sparse SNAP ids are renumbered." << std::endl;
+    std::cout << "A file ending with \".edges\" is read as a sorted binary edge file, written by `newg` with `filename`." << std::endl;
+    std::cout << "A file ending with \".geg\" is read as a binary graph, written by `exportg` with `binary`. It is mapped and its row offsets are checked, nothing is parsed. Add option `verify` (no value) to check it against its checksum as well, e.g. GraphEngine import -verify -g.geg." << std::endl;
     std::cout << "Make sure that graph name NOT repeated, it will cause conflict. If so, use index." << std::endl;
 }
 
 void printHelpNewg() {
-    std::cout << "Command: `newg` to create a specific new graph. Option list: {name, category, nodecount, size, dim, degree, connectrate, isregular, category}. Value: name refers to graph name(may empty), default for empty; category is essential, others are optional." << std::endl;
+    std::cout << "Command: `newg` to create a specific new graph. Option list: {name, category, nodecount, size, dim, degree, connectrate, isregular, initiator, like, filename}. Value: name refers to graph name(may empty), default for empty; category is essential, others are optional." << std::endl;
     std::cout << "Option name refers to graph name, default for empty. Make sure that graph name NOT repeated, it will cause conflict. If so, use index." << std::endl;
-    std::cout << "Category(essential) refers to graph structure, only \"fc\", \"lattice\", \"ring\", \"or\", \"er\" and \"basf\" are support. Others may use import to create, see help -import. Different `category` need different optional option(s)." << std::endl;
+    std::cout << "Category(essential) refers to graph structure, only \"fc\", \"lattice\", \"ring\", \"or\", \"er\", \"basf\", \"rmat\" and \"cm\" are support. Others may use import to create, see help -import. Different `category` need different optional option(s)." << std::endl;
     std::cout << "\tCategory fc: full connect structure, `nodecount` is essential for node count." << std::endl;
     std::cout << "\tCategory lattice: lattice structure, `size` is essential for graph size in every dimension, `dim` is optional for dimension(default value is 2)." << std::endl;
     std::cout << "\tCategory ring: ring structure, `nodecount` and `degree` are essential for node count and degree, respectively." << std::endl;
     std::cout << "\tCategory or: odd-degree regular structure, `nodecount` and `degree` are essential for node count and degree, respectively." << std::endl;
     std::cout << "\tCategory er: E-R random structure, structure, `nodecount`, `degree` and `connectrate` are essential for node count (average) degree and node-pair connect rate, respectively, `isregular` is optional for whether the network is regular or not(default value is FALSE, only \"True\" can activate it)." << std::endl;
     std::cout << "\tCategory basf: B-A scale-free structure, `nodecount` and `degree` are essential for node count and average degree, respectively." << std::endl;
+    std::cout << "\tCategory rmat: R-MAT (Kronecker) skewed structure in Graph500 style, `size` is essential for the scale (2^size nodes), `degree` is optional for the edge factor (edges per node, default value is 16), and `initiator` is optional for probabilities a,b,c of the 2x2 initiator (default value is 0.57,0.19,0.19)." << std::endl;
+    std::cout << "\tCategory cm: configuration model, `like` is essential for the index of an existed graph whose degrees are copied, `nodecount` is optional to draw that many degrees from its degree distribution instead." << std::endl;
+    std::cout << "Option `filename` streams the graph into a sorted binary edge file instead of the graph list, memory stays bounded for graphs larger than RAM. It works for fc, lattice, ring, or, irregular er and rmat. Use import with a \".edges\" file to load it back." << std::endl;
     std::cout << "Each option need at most one value for once `newg` command, twice or more use will overwrite." << std::endl;
     std::cout << "For example, GraphEngine newg -category =basf -name =myGraph1 -nodecount =1000 -degree =4." << std::endl;
     std::cout << "It will create a B-A scale-free structured graph with 1000 nodes and 4 average degree, and will be named by \"myGraph1\"." << std::endl;
@@ -831,9 +1630,11 @@ void printHelpCheck() {
 }
 
 void printHelpExportg() {
-    std::cout << "Command: `exportg` to export specific graph\'s all node information and all the edges. Option list: {index, name, filename}, all of options are optional. `Index` and `name` are to locate exact graph, `filename` is to specify the export file name, default export the zeroth graph into nodes_exportg.csv and edges_exportg.csv." << std::endl;
+    std::cout << "Command: `exportg` to export specific graph\'s all node information and all the edges. Option list: {index, name, filename, binary, matrix}, all of options are optional. `Index` and `name` are to locate exact graph, `filename` is to specify the export file name, default export the zeroth graph into nodes_exportg.csv and edges_exportg.csv." << std::endl;
     std::cout << "Option `index` is to locate the `index`\'s \"value\"th graph, and `name` is to locate the first graph with `name`\'s \"value\". Located graph will be export at this command, default export zeroth graph." << std::endl;
     std::cout << "Option `filename` is to specify a new file to output, default `filename` is \"exportg\". This command will not edit an existed file, please check \"nodes_`filename`XXX.csv\" and \"edges_`filename`XXX.csv\" when finished." << std::endl;
+    std::cout << "Option `binary` does not need any value. It writes the graph into one binary \"`filename`XXX.geg\" file instead (offsets, neighbor ids, weights and a checksum), which `import` maps back without parsing." << std::endl;
+    std::cout << "Option `matrix` does not need any value. It writes all-pairs distances into one binary \"matrix_`filename`XXX.ged\" file instead, an undirected graph keeps only the lower triangle and an unweighted graph keeps hop counts in 1, 2 or 4 byte integers. It can be combined with `binary`." << std::endl;
     std::cout << "Nodes information includes node index, reachable node count, degree distribution and minimum distance to any other nodes." << std::endl;
     std::cout << "Edges information are all of the edges, i.e. start node, end node and weight. Especially, the first line is node count, edge count and is directed, so you can just use `import` to reprocess this graph(see help -import)." << std::endl;
     std::cout << "For example, GraphEngine exportg -index =1 -filename =exportA exportg -name =WS -filename =exportB." << std::endl;
@@ -843,12 +1644,69 @@ void printHelpExportg() {
 void printHelpOutput() {
     std::cout << "Command: `output` to export all the graphs\' abstract in list. Option(optional): filename, only the first optional will effective. Value: the output file name." << std::endl;
     std::cout << "Option `filename` is to specify a new file to output, default `filename` is \"output\". This command will not edit an existed file, please check \"`filename`XXX.csv\" when finished." << std::endl;
-    std::cout << "Graph abstract includes graph\'s index, name, whether direct or not, node count, edge count, average degree, degree variance, cluster coefficient, minimum distance between two nodes, average distance between two nodes and maximum distance between two nodes." << std::endl;
+    std::cout << "Graph abstract includes graph\'s index, name, whether direct or not, node count, edge count, average degree, degree variance, cluster coefficient, minimum distance between two nodes, average distance between two nodes, maximum distance between two nodes, Louvain community count and its modularity." << std::endl;
     std::cout << "Output will according to list order." << std::endl;
     std::cout << "For example, GraphEngine output -filename =outA -filename =outB." << std::endl;
     std::cout << "Then you will see a new \"outAXXX.csv\" file, just open it and read." << std::endl;
 }
 
+void printHelpPagerank() {
+    std::cout << "Command: `pagerank` to calculate (personalized) PageRank of the specific graph. Option list: {index, name, damping, source, warm, filename}, all of options are optional, default calculate the zeroth graph into pagerank.csv." << std::endl;
+    std::cout << "Option `index` is to locate the `index`\'s \"value\"th graph, and `name` is to locate the first graph with `name`\'s \"value\". Located graph will be ranked at this command, default rank zeroth graph." << std::endl;
+    std::cout << "Option `damping` is the damping factor in (0, 1), default value is 0.85." << std::endl;
+    std::cout << "Option `source` is a node index that random surfers teleport to. It can be used several times, then PageRank will be personalized on all these nodes." << std::endl;
+    std::cout << "Option `warm` does not need any value. It starts from the previous PageRank of the graph with same name in this run, so re-ranking after a small `edit` converges in few iterations." << std::endl;
+    std::cout << "Option `filename` is to specify a new file to output, default `filename` is \"pagerank\". This command will not edit an existed file, please check \"`filename`XXX.csv\" when finished." << std::endl;
+    std::cout << "Edge weights are ignored, directed graph is ranked along its edge direction." << std::endl;
+    std::cout << "For example, GraphEngine pagerank -index =0 edit -index =0 -ae =3,4,1.0 pagerank -index =0 -warm -filename =pr2." << std::endl;
+    std::cout << "Then you will see \"pagerank.csv\" and \"pr2.csv\", the second one is warm started from the first one." << std::endl;
+}
+
+void printHelpOracle() {
+    std::cout << "Command: `oracle` to build (or load) an exact hop distance index of the specific graph and answer point-to-point queries. Option list: {index, name, load, filename, query}, all of options are optional, default index the zeroth graph into oracle.pll." << std::endl;
+    std::cout << "Option `index` is to locate the `index`\'s \"value\"th graph, and `name` is to locate the first graph with `name`\'s \"value\". Located graph (must be undirected) will be indexed by pruned landmark labeling, default index zeroth graph." << std::endl;
+    std::cout << "Option `filename` is to specify a new file to save the index, default `filename` is \"oracle\". This command will not edit an existed file, please check \"`filename`XXX.pll\" when finished." << std::endl;
+    std::cout << "Option `load` is to read a saved index file instead of building one, then no graph is needed." << std::endl;
+    std::cout << "Option `query` need an value format as \"2,3\", refers to start node and end node. It can be used several times, every answer is the exact hop count, edge weights are ignored." << std::endl;
+    std::cout << "For example, GraphEngine newg -category =basf -nodecount =10000 -degree =4 oracle -filename =ba, and later GraphEngine oracle -load =ba.pll -query =0,9999 -query =5,42." << std::endl;
+    std::cout << "The first run builds and saves the index with its memory usage, the second one only loads it and answers two queries." << std::endl;
+}
+
+void printHelpEnsemble() {
+    std::cout << "Command: `ensemble` to generate many random graphs of one category with consecutive seeds and summarize their statistics. Option list: {category, nodecount, size, degree, connectrate, isregular, initiator, seed, count, stats, filename}, category is essential, default summarize 32 graphs into ensemble.csv." << std::endl;
+    std::cout << "Category(essential) only supports random structures: \"er\", \"basf\", \"ws\" and \"rmat\". Options of \"er\", \"basf\" and \"rmat\" are the same as `newg` (see help -newg), \"ws\" is a ring of `nodecount` and `degree` rewired by `connectrate`." << std::endl;
+    std::cout << "Option `seed` is the first seed (default value is 1) and `count` is the number of graphs (default value is 32), the i-th graph uses seed `seed`+i, so the same options always give the same result whatever the thread count." << std::endl;
+    std::cout << "Option `stats` is a comma list from {size, degree, cluster, distance, core, community}, default value is \"size,degree,cluster\"." << std::endl;
+    std::cout << "Option `filename` is to specify a new file to output, default `filename` is \"ensemble\". This command will not edit an existed file, please check \"`filename`XXX.csv\" when finished." << std::endl;
+    std::cout << "Every line of the file is a statistic with its key (the degree for degreeDistribution, -1 otherwise), sample count, mean, variance and the 95% confidence interval of the mean." << std::endl;
+    std::cout << "Graphs are generated in parallel, one per thread at a time, and they are not added into the graph list." << std::endl;
+    std::cout << "For example, GraphEngine ensemble -category =basf -nodecount =10000 -degree =4 -count =200 -stats =degree,cluster,core." << std::endl;
+    std::cout << "Then you will see a new \"ensemble.csv\" file with 200 B-A graphs summarized, including the averaged degree distribution P(k)." << std::endl;
+}
+
+void printHelpPercolation() {
+    std::cout << "Command: `percolation` to remove nodes (or edges) of the specific graph one by one and record the giant component size after every removal. Option list: {index, name, strategy, repeat, bond, filename}, all of options are optional, default remove nodes of the zeroth graph in random order into percolation.csv." << std::endl;
+    std::cout << "Option `index` is to locate the `index`\'s \"value\"th graph, and `name` is to locate the first graph with `name`\'s \"value\". Located graph will be attacked at this command, default attack zeroth graph." << std::endl;
+    std::cout << "Option `strategy` is the removal order, \"random\" (default) for random failures and \"degree\" for attacks on the highest degree first (highest degree product for edges), ties are broken randomly." << std::endl;
+    std::cout << "Option `repeat` is the number of Monte Carlo repeats to average (default value is 1), they run on all threads." << std::endl;
+    std::cout << "Option `bond` does not need any value. It removes edges instead of nodes." << std::endl;
+    std::cout << "Option `filename` is to specify a new file to output, default `filename` is \"percolation\". This command will not edit an existed file, please check \"`filename`XXX.csv\" when finished." << std::endl;
+    std::cout << "Every line of the file is the removed count and the average giant component size as a fraction of the node count. Edge direction and weights are ignored." << std::endl;
+    std::cout << "For example, GraphEngine newg -category =basf -nodecount =100000 -degree =4 percolation -strategy =degree -repeat =16 -filename =attack." << std::endl;
+    std::cout << "Then you will see a new \"attack.csv\" file, the scale-free graph falls apart after a small fraction of hubs is removed." << std::endl;
+}
+
+void printHelpSimulate() {
+    std::cout << "Command: `simulate` to run SIR, SIS or independent cascade spreading on the specific graph many times. Option list: {index, name, model, infectrate, recoverrate, source, repeat, steps, filename}, `infectrate` is essential, default run SIR once on the zeroth graph into curve_simulate.csv and outbreak_simulate.csv." << std::endl;
+    std::cout << "Option `index` is to locate the `index`\'s \"value\"th graph, and `name` is to locate the first graph with `name`\'s \"value\". Spreading runs along the edges (out-edges for directed graph) of the located graph, edge weights are ignored." << std::endl;
+    std::cout << "Option `model` is \"sir\" (default), \"sis\" or \"ic\". Every step, each infected node infects each susceptible neighbor with `infectrate` and then recovers with `recoverrate` (default value is 1); SIS nodes become susceptible again, and independent cascade gives every node only one chance." << std::endl;
+    std::cout << "Option `source` is a node index infected at the start. It can be used several times, without it every realization starts from one random node." << std::endl;
+    std::cout << "Option `repeat` is the number of independent realizations (default value is 1), they run on all threads. Option `steps` limits the steps of every realization (default value is 1000)." << std::endl;
+    std::cout << "Option `filename` is to specify new files to output, default `filename` is \"simulate\". This command will not edit an existed file, please check \"curve_`filename`XXX.csv\" for the average infected and recovered count at every step and \"outbreak_`filename`XXX.csv\" for the outbreak size distribution when finished." << std::endl;
+    std::cout << "For example, GraphEngine newg -category =basf -nodecount =100000 -degree =4 simulate -infectrate =0.1 -recoverrate =0.2 -repeat =1000." << std::endl;
+    std::cout << "Then you will see the epidemic curve and outbreak sizes of 1000 SIR realizations, each from a random node." << std::endl;
+}
+
 StrOpt s2e(const std::string_view str) {
     if (str == "import") return StrOpt::import;
     if (str == "newg") return StrOpt::newg;
@@ -856,6 +1714,11 @@ StrOpt s2e(const std::string_view str) {
     if (str == "check") return StrOpt::check;
     if (str == "exportg") return StrOpt::exportg;
     if (str == "output") return StrOpt::output;
+    if (str == "pagerank") return StrOpt::pagerank;
+    if (str == "oracle") return StrOpt::oracle;
+    if (str == "ensemble") return StrOpt::ensemble;
+    if (str == "percolation") return StrOpt::percolation;
+    if (str == "simulate") return StrOpt::simulate;
     if (str == "nodecount") return StrOpt::nodecount;
     if (str == "size") return StrOpt::size;
     if (str == "dim") return StrOpt::dim;
@@ -863,6 +1726,8 @@ StrOpt s2e(const std::string_view str) {
     if (str == "connectrate") return StrOpt::connectrate;
     if (str == "isregular") return StrOpt::isregular;
     if (str == "category") return StrOpt::category;
+    if (str == "initiator") return StrOpt::initiator;
+    if (str == "like") return StrOpt::like;
     if (str == "name") return StrOpt::name;
     if (str == "index") return StrOpt::index;
     if (str == "rename") return StrOpt::rename;
@@ -876,5 +1741,22 @@ StrOpt s2e(const std::string_view str) {
     if (str == "rn") return StrOpt::rn;
     if (str == "re") return StrOpt::re;
     if (str == "filename") return StrOpt::filename;
+    if (str == "damping") return StrOpt::damping;
+    if (str == "source") return StrOpt::source;
+    if (str == "warm") return StrOpt::warm;
+    if (str == "load") return StrOpt::load;
+    if (str == "query") return StrOpt::query;
+    if (str == "seed") return StrOpt::seed;
+    if (str == "count") return StrOpt::count;
+    if (str == "stats") return StrOpt::stats;
+    if (str == "strategy") return StrOpt::strategy;
+    if (str == "repeat") return StrOpt::repeat;
+    if (str == "bond") return StrOpt::bond;
+    if (str == "model") return StrOpt::model;
+    if (str == "infectrate") return StrOpt::infectrate;
+    if (str == "recoverrate") return StrOpt::recoverrate;
+    if (str == "steps") return StrOpt::steps;
+    if (str == "binary") return StrOpt::binary;
+    if (str == "matrix") return StrOpt::matrix;
     return StrOpt::unknown;
 }
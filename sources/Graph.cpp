@@ -2,15 +2,172 @@
 // Created by Ivor on 2025/12/20.
 //
 
+#include <atomic>
+
 #include "../headers/Graph.h"
+#include "../headers/parallel.h"
 
 Graph::Graph(const int nodeCount, const bool directed) : directed(directed), nodeCount(nodeCount) {
     this->edgeCount = 0;
-    this->adjacencyList = std::vector<std::vector<std::pair<int, double>>>(nodeCount, std::vector<std::pair<int, double>>(0, std::pair<int, double>(0, 0.)));
+    this->rowBlocks.resize((nodeCount + blockMask) >> blockShift);
+    for (std::shared_ptr<RowBlock>& block: this->rowBlocks) {
+        block = std::make_shared<RowBlock>();
+    }
+}
+
+Graph::Graph(const int nodeCount, const std::vector<std::tuple<int, int, double>>& edges, const bool directed) : Graph(nodeCount, directed) {
+    /* Same result as `addEdges`, but every list is filled once and sorted once instead of an insert per edge. */
+    const int edgeTotal = static_cast<int>(edges.size());
+    std::vector<int> rowSize(nodeCount, 0);
+    std::vector<char> valid(edgeTotal, 0);
+    for (int e = 0; e < edgeTotal; ++e) {
+        const auto& [left, right, weight] = edges[e];
+        if (left < 0 || left >= nodeCount) {
+            std::cerr << "The first node index(" << left << ") of the new edge [" << left << ", " << right << "] out of this graph with " << nodeCount << " node(s)." << std::endl;
+            continue;
+        }
+        if (right < 0 || right >= nodeCount) {
+            std::cerr << "The second node index(" << right << ") of the new edge [" << left << ", " << right << "] out of this graph with " << nodeCount << " node(s)." << std::endl;
+            continue;
+        }
+        valid[e] = 1;
+        rowSize[left]++;
+        if (!directed) {
+            rowSize[right]++; // An undirected self-loop lands twice, just like `addEdge` doubles its weight.
+        }
+    }
+    /* Every worker owns a range of rows (balanced by entries). Edges are split into one stride per worker, counted
+     * per owner, then staged grouped by owner at cursors from a prefix sum, so each edge is read once in all and no
+     * write is shared. Each owner then fills its rows from its own group, in input order. */
+    std::vector<std::size_t> rowOffset(nodeCount + 1, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        rowOffset[i + 1] = rowOffset[i] + rowSize[i];
+    }
+    const int workers = std::max(1, std::min(threadCount(), nodeCount));
+    const std::vector<int> bounds = balancedPartition(rowOffset, workers);
+    std::vector<int> owner(nodeCount);
+    for (int t = 0; t < workers; ++t) {
+        std::fill(owner.begin() + bounds[t], owner.begin() + bounds[t + 1], t);
+    }
+    std::vector<std::vector<std::size_t>> cursor(workers, std::vector<std::size_t>(workers, 0));
+    const auto stride = [edgeTotal, workers](const int t) {
+        return static_cast<int>(static_cast<long long>(edgeTotal) * t / workers);
+    };
+    runWorkers(workers, [&](const int t) {
+        for (int e = stride(t); e < stride(t + 1); ++e) {
+            if (!valid[e]) {
+                continue;
+            }
+            cursor[t][owner[std::get<0>(edges[e])]]++;
+            if (!directed) {
+                cursor[t][owner[std::get<1>(edges[e])]]++;
+            }
+        }
+    });
+    std::vector<std::size_t> groupStart(workers + 1, 0);
+    std::size_t position = 0;
+    for (int o = 0; o < workers; ++o) {
+        groupStart[o] = position;
+        for (int t = 0; t < workers; ++t) {
+            const std::size_t count = cursor[t][o];
+            cursor[t][o] = position;
+            position += count;
+        }
+    }
+    groupStart[workers] = rowOffset[nodeCount];
+    std::vector<std::tuple<int, int, double>> staged(rowOffset[nodeCount]); // (row, neighbor, weight)
+    runWorkers(workers, [&](const int t) {
+        for (int e = stride(t); e < stride(t + 1); ++e) {
+            if (!valid[e]) {
+                continue;
+            }
+            const auto& [left, right, weight] = edges[e];
+            staged[cursor[t][owner[left]]++] = {left, right, weight};
+            if (!directed) {
+                staged[cursor[t][owner[right]]++] = {right, left, weight};
+            }
+        }
+    });
+    runWorkers(workers, [&](const int t) {
+        for (int i = bounds[t]; i < bounds[t + 1]; ++i) {
+            this->row(i).reserve(rowSize[i]);
+        }
+        for (std::size_t k = groupStart[t]; k < groupStart[t + 1]; ++k) {
+            const auto& [i, neighbor, weight] = staged[k];
+            this->row(i).emplace_back(neighbor, weight);
+        }
+    });
+    std::vector<long long> partialCount(threadCount(), 0);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, const int t) {
+        long long count = 0;
+        for (int i = begin; i < end; ++i) {
+            std::vector<std::pair<int, double>>& neighbors = this->row(i);
+            std::ranges::sort(neighbors); // Whole pairs, so merged weights add up in a fixed order.
+            std::size_t kept = 0;
+            for (std::size_t k = 0; k < neighbors.size(); ++k) {
+                if (kept && neighbors[kept - 1].first == neighbors[k].first) {
+                    neighbors[kept - 1].second += neighbors[k].second;
+                } else {
+                    neighbors[kept++] = neighbors[k];
+                }
+            }
+            neighbors.resize(kept);
+            count += static_cast<long long>(kept);
+            if (!directed && std::ranges::binary_search(neighbors, std::make_pair(i, 0.), [](const std::pair<int, double>& left, const std::pair<int, double>& right) {
+                return left.first < right.first;
+            })) {
+                count++; // A self-loop is a single entry but still one whole edge.
+            }
+        }
+        partialCount[t] = count;
+    });
+    long long count = 0;
+    for (const long long c: partialCount) {
+        count += c;
+    }
+    this->edgeCount = static_cast<int>(directed ? count : count / 2);
+}
+
+Graph::Graph(const int nodeCount, const std::function<void(int, std::vector<std::pair<int, double>>&)>& rowBuilder, const bool directed) : Graph(nodeCount, directed) {
+    /* For topologies known in advance: `rowBuilder` writes the whole neighbor list of one node, rows are written
+     * in parallel and nothing is searched or inserted. An undirected graph must get symmetric rows. */
+    std::vector<long long> partialCount(threadCount(), 0);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, const int t) {
+        long long count = 0;
+        for (int i = begin; i < end; ++i) {
+            std::vector<std::pair<int, double>>& neighbors = this->row(i);
+            rowBuilder(i, neighbors);
+            if (!std::ranges::is_sorted(neighbors)) {
+                std::ranges::sort(neighbors);
+            }
+            count += static_cast<long long>(neighbors.size());
+            if (!directed && std::ranges::binary_search(neighbors, std::make_pair(i, 0.), [](const std::pair<int, double>& left, const std::pair<int, double>& right) {
+                return left.first < right.first;
+            })) {
+                count++; // A self-loop is a single entry but still one whole edge.
+            }
+        }
+        partialCount[t] = count;
+    });
+    long long count = 0;
+    for (const long long c: partialCount) {
+        count += c;
+    }
+    this->edgeCount = static_cast<int>(directed ? count : count / 2);
 }
 
 Graph::~Graph() = default;
 
+std::vector<std::pair<int, double>>& Graph::row(const int nodeIndex) {
+    std::shared_ptr<RowBlock>& block = this->rowBlocks[nodeIndex >> blockShift];
+    if (block.use_count() > 1) {
+        block = std::make_shared<RowBlock>(*block); // Copy on write, other graphs keep the old rows.
+    } else {
+        std::atomic_thread_fence(std::memory_order_acquire); // Reads through a copy released on another thread are done.
+    }
+    return block->rows[nodeIndex & blockMask];
+}
+
 bool Graph::isDirected() const {
     return this->directed;
 }
@@ -29,7 +186,7 @@ const std::vector<std::pair<int, double>>& Graph::getNeighbors(const int nodeInd
         std::cerr << "Can not get " << nodeIndex << "th node in " << this->getNodeCount() << "node(s) graph." << std::endl;
         return empty;
     }
-    return adjacencyList[nodeIndex];
+    return this->rowBlocks[nodeIndex >> blockShift]->rows[nodeIndex & blockMask];
 }
 
 void Graph::addNode() {
@@ -37,9 +194,11 @@ void Graph::addNode() {
 }
 
 void Graph::addNodes(const int count) {
-    this->nodeCount += count;
     for (int i = 0; i < count; i++) {
-        this->adjacencyList.emplace_back(0);
+        if (!(this->nodeCount & blockMask)) {
+            this->rowBlocks.push_back(std::make_shared<RowBlock>());
+        }
+        this->nodeCount++;
     }
 }
 
@@ -55,25 +214,27 @@ void Graph::addEdge(const std::tuple<int, int, double>& edge) {
     this->edgeCount ++;
     int left = std::get<0>(edge), right = std::get<1>(edge);
     double weight = std::get<2>(edge);
+    std::vector<std::pair<int, double>>& leftRow = this->row(left);
     for (int i = 0; i <= this->getNeighbors(left).size(); ++i) {
-        if (i != this->getNeighbors(left).size() && right == this->adjacencyList[left][i].first) {
-            this->adjacencyList[left][i].second += weight;
+        if (i != this->getNeighbors(left).size() && right == leftRow[i].first) {
+            leftRow[i].second += weight;
             this->edgeCount --;
             break;
         }
-        if (i == this->getNeighbors(left).size() || right < this->adjacencyList[left][i].first) {
-            this->adjacencyList[left].insert(this->adjacencyList[left].begin() + i, std::pair<int, double>(right, weight));
+        if (i == this->getNeighbors(left).size() || right < leftRow[i].first) {
+            leftRow.insert(leftRow.begin() + i, std::pair<int, double>(right, weight));
             break;
         }
     }
     if (!this->isDirected()) {
+        std::vector<std::pair<int, double>>& rightRow = this->row(right);
         for (int i = 0; i <= this->getNeighbors(right).size(); ++i) {
-            if (i != this->getNeighbors(right).size() && left == this->adjacencyList[right][i].first) {
-                this->adjacencyList[right][i].second += weight;
+            if (i != this->getNeighbors(right).size() && left == rightRow[i].first) {
+                rightRow[i].second += weight;
                 break;
             }
-            if (i == this->getNeighbors(right).size() || left < this->adjacencyList[right][i].first) {
-                this->adjacencyList[right].insert(this->adjacencyList[right].begin() + i, std::pair<int, double>(left, weight));
+            if (i == this->getNeighbors(right).size() || left < rightRow[i].first) {
+                rightRow.insert(rightRow.begin() + i, std::pair<int, double>(left, weight));
                 break;
             }
         }
@@ -106,15 +267,15 @@ void Graph::updateEdgeWeight(const std::tuple<int, int, double>& newEdge) {
             std::cerr << "Cannot find such edge [" << left << ", " << right << "] in graph." << std::endl;
             return;
         }
-        if (right == this->adjacencyList[left][i].first) {
-            this->adjacencyList[left][i].second = weight;
+        if (right == this->getNeighbors(left)[i].first) {
+            this->row(left)[i].second = weight;
             break;
         }
     }
     if (!this->isDirected()) {
         for (int i = 0; i < this->getNeighbors(right).size(); ++i) {
-            if (left == this->adjacencyList[right][i].first) {
-                this->adjacencyList[right][i].second = weight;
+            if (left == this->getNeighbors(right)[i].first) {
+                this->row(right)[i].second = weight;
                 break;
             }
         }
@@ -136,18 +297,26 @@ void Graph::removeNode(int index) {
         if (i == index) {
             continue;
         }
-        std::vector<std::pair<int, double>>& neighbors = this->adjacencyList[i];
-        const int size = static_cast<int>(neighbors.size());
-        std::erase_if(neighbors, [index](const std::pair<int, double>& obj){
+        const auto linked = [index](const std::pair<int, double>& obj){
             return obj.first == index;
-        });
+        };
+        if (std::ranges::none_of(this->getNeighbors(i), linked)) {
+            continue; // Left untouched, so its block can stay shared.
+        }
+        std::erase_if(this->row(i), linked);
         if (this->isDirected()) {
-            this->edgeCount -= (size != static_cast<int>(neighbors.size()));
+            this->edgeCount --;
         }
     }
-    this->edgeCount -= static_cast<int>(this->adjacencyList[index].size());
-    this->adjacencyList.erase(this->adjacencyList.begin() + index);
+    this->edgeCount -= static_cast<int>(this->getNeighbors(index).size());
+    for (int i = index; i + 1 < this->getNodeCount(); ++i) {
+        this->row(i) = std::move(this->row(i + 1));
+    }
+    std::vector<std::pair<int, double>>().swap(this->row(this->getNodeCount() - 1));
     this->nodeCount --;
+    if (static_cast<int>(this->rowBlocks.size()) > (this->nodeCount + blockMask) >> blockShift) {
+        this->rowBlocks.pop_back();
+    }
 }
 
 void Graph::removeNodes(std::vector<int> index) {
@@ -165,7 +334,7 @@ void Graph::removeEdge(std::pair<int, int> neighborPair) {
         return;
     }
     const int size = static_cast<int>(this->getNeighbors(neighborPair.first).size());
-    std::vector<std::pair<int, double>>& neighbors = this->adjacencyList[neighborPair.first];
+    std::vector<std::pair<int, double>>& neighbors = this->row(neighborPair.first);
     std::erase_if(neighbors, [neighborPair](const std::pair<int, double>& neighbor) {
         return neighborPair.second == neighbor.first;
     });
@@ -175,7 +344,7 @@ void Graph::removeEdge(std::pair<int, int> neighborPair) {
     }
     this->edgeCount --;
     if (!this->isDirected()) {
-        std::vector<std::pair<int, double>>& opNeighbors = this->adjacencyList[neighborPair.second];
+        std::vector<std::pair<int, double>>& opNeighbors = this->row(neighborPair.second);
         std::erase_if(opNeighbors, [neighborPair](const std::pair<int, double>& neighbor) {
             return neighborPair.first == neighbor.first;
         });
@@ -2,13 +2,210 @@
 // Created by Ivor on 2025/12/22.
 //
 
+#include <barrier>
+#include <cmath>
+
 #include "../headers/algorithm.h"
+#include "../headers/parallel.h"
 
-bool dfs(const Graph& graph) {
+namespace {
+    /* Reusable state of one point-to-point search. A node is visited on a side only if its stamp equals the
+     * current generation, so starting a new query never clears the arrays. */
+    struct SearchBuffer {
+        unsigned generation = 0;
+        std::vector<unsigned> stamp[2];
+        std::vector<double> dist[2];
+        std::vector<int> parent[2], frontier[2], next;
+        std::vector<std::pair<double, int>> heap[2];
+
+        explicit SearchBuffer(const int nodeCount) {
+            for (int side = 0; side < 2; ++side) {
+                stamp[side].assign(nodeCount, 0);
+                dist[side].resize(nodeCount);
+                parent[side].resize(nodeCount);
+            }
+        }
+        void reset() {
+            if (++generation == 0) { // Wrapped around, old stamps could alias.
+                std::ranges::fill(stamp[0], 0);
+                std::ranges::fill(stamp[1], 0);
+                generation = 1;
+            }
+        }
+        [[nodiscard]] bool seen(const int side, const int v) const {
+            return stamp[side][v] == generation;
+        }
+        void visit(const int side, const int v, const double d, const int p) {
+            stamp[side][v] = generation;
+            dist[side][v] = d;
+            parent[side][v] = p;
+        }
+    };
+
+    /* In-edges for the backward side of a directed graph, an undirected graph searches backward on itself. */
+    struct ReverseGraph {
+        std::vector<std::size_t> offset;
+        std::vector<std::pair<int, double>> edge;
+
+        explicit ReverseGraph(const Graph& graph) {
+            if (!graph.isDirected()) {
+                return;
+            }
+            const int nc = graph.getNodeCount();
+            offset.assign(nc + 1, 0);
+            for (int i = 0; i < nc; ++i) {
+                for (const auto& [destination, weight]: graph.getNeighbors(i)) {
+                    offset[destination + 1]++;
+                }
+            }
+            for (int i = 0; i < nc; ++i) {
+                offset[i + 1] += offset[i];
+            }
+            edge.resize(offset[nc]);
+            std::vector<std::size_t> fill(offset.begin(), offset.end() - 1);
+            for (int i = 0; i < nc; ++i) {
+                for (const auto& [destination, weight]: graph.getNeighbors(i)) {
+                    edge[fill[destination]++] = {i, weight};
+                }
+            }
+        }
+        template <typename Function>
+        void forEach(const Graph& graph, const int side, const int v, Function&& function) const {
+            if (!side || !graph.isDirected()) {
+                for (const auto& [neighbor, weight]: graph.getNeighbors(v)) {
+                    function(neighbor, weight);
+                }
+                return;
+            }
+            for (std::size_t k = offset[v]; k < offset[v + 1]; ++k) {
+                function(edge[k].first, edge[k].second);
+            }
+        }
+    };
+}
+
+static std::vector<int> meetPath(const SearchBuffer& buffer, const int meet) {
+    std::vector<int> path;
+    for (int v = meet; ~v; v = buffer.parent[0][v]) {
+        path.push_back(v);
+    }
+    std::ranges::reverse(path);
+    for (int v = buffer.parent[1][meet]; ~v; v = buffer.parent[1][v]) {
+        path.push_back(v);
+    }
+    return path;
+}
+
+/* Level-synchronous from both ends, always expanding the smaller frontier. Returns the meeting node or -1. */
+static int searchBfs(const Graph& graph, const ReverseGraph& reverse, SearchBuffer& buffer, const int source, const int target) {
+    buffer.reset();
+    buffer.visit(0, source, 0., -1);
+    buffer.visit(1, target, 0., -1);
+    if (source == target) {
+        return source;
+    }
+    buffer.frontier[0].assign(1, source);
+    buffer.frontier[1].assign(1, target);
+    while (!buffer.frontier[0].empty() && !buffer.frontier[1].empty()) {
+        const int side = buffer.frontier[0].size() <= buffer.frontier[1].size() ? 0 : 1;
+        int meet = -1;
+        double best = unreachable;
+        buffer.next.clear();
+        for (const int u: buffer.frontier[side]) {
+            reverse.forEach(graph, side, u, [&](const int v, double) {
+                if (buffer.seen(side, v)) {
+                    return;
+                }
+                buffer.visit(side, v, buffer.dist[side][u] + 1., u);
+                buffer.next.push_back(v);
+                if (buffer.seen(1 - side, v) && buffer.dist[0][v] + buffer.dist[1][v] < best) {
+                    best = buffer.dist[0][v] + buffer.dist[1][v];
+                    meet = v;
+                }
+            });
+        }
+        if (~meet) {
+            return meet; // The whole level is finished, so `best` is minimal.
+        }
+        buffer.frontier[side].swap(buffer.next);
+    }
+    return -1;
+}
+
+/* Alternating Dijkstra from both ends, it stops once the two heap tops cannot beat the best meeting. */
+static int searchDijkstra(const Graph& graph, const ReverseGraph& reverse, SearchBuffer& buffer, const int source, const int target) {
+    buffer.reset();
+    buffer.visit(0, source, 0., -1);
+    buffer.visit(1, target, 0., -1);
+    if (source == target) {
+        return source;
+    }
+    constexpr auto greater = std::greater<std::pair<double, int>>();
+    for (int side = 0; side < 2; ++side) {
+        buffer.heap[side].assign(1, {0., side ? target : source});
+    }
+    int meet = -1;
+    double best = unreachable;
+    bool negative = false;
+    while (!buffer.heap[0].empty() && !buffer.heap[1].empty() && !negative) {
+        if (buffer.heap[0].front().first + buffer.heap[1].front().first >= best) {
+            break;
+        }
+        const int side = buffer.heap[0].size() <= buffer.heap[1].size() ? 0 : 1;
+        std::vector<std::pair<double, int>>& heap = buffer.heap[side];
+        std::ranges::pop_heap(heap, greater);
+        const auto [du, u] = heap.back();
+        heap.pop_back();
+        if (du > buffer.dist[side][u]) {
+            continue; // Stale entry.
+        }
+        reverse.forEach(graph, side, u, [&](const int v, const double weight) {
+            if (weight < 0.) {
+                negative = true;
+                return;
+            }
+            if (buffer.seen(side, v) && buffer.dist[side][v] <= du + weight) {
+                return;
+            }
+            buffer.visit(side, v, du + weight, u);
+            heap.emplace_back(du + weight, v);
+            std::ranges::push_heap(heap, greater);
+            if (buffer.seen(1 - side, v) && buffer.dist[0][v] + buffer.dist[1][v] < best) {
+                best = buffer.dist[0][v] + buffer.dist[1][v];
+                meet = v;
+            }
+        });
+    }
+    if (negative) {
+        std::cerr << "Dijkstra cannot search a graph with negative weight(s), use floyd instead." << std::endl;
+        return -1;
+    }
+    return meet;
+}
+
+static bool validPair(const Graph& graph, const std::pair<int, int>& objPair) {
     if (!graph.getNodeCount()) {
         std::cerr << "Cannot search for an empty graph." << std::endl;
         return false;
     }
+    if (objPair.first < 0 || objPair.first >= graph.getNodeCount()) {
+        std::cerr << "The beginning point " << objPair.first << " is not in this graph with " << graph.getNodeCount() << " node(s)." << std::endl;
+        return false;
+    }
+    if (objPair.second < 0 || objPair.second >= graph.getNodeCount()) {
+        std::cerr << "The ending point " << objPair.second << " is not in this graph with " << graph.getNodeCount() << " node(s)." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/* Searches shared by a graph and a view, nodes outside a view are neither started from nor waited for. */
+template <typename Network>
+static bool depthFirst(const Network& graph) {
+    if (!memberCount(graph)) {
+        std::cerr << "Cannot search for an empty graph." << std::endl;
+        return false;
+    }
     std::vector<bool> visit(graph.getNodeCount(), false);
     std::function<void(int)> dfsLambda = [&](const int index) {
         visit[index] = true;
@@ -18,20 +215,30 @@ bool dfs(const Graph& graph) {
             }
         }
     };
-    dfsLambda(0);
-    return std::ranges::all_of(visit, [](const bool isTrue) {return isTrue;});
+    int start = 0;
+    while (!isMember(graph, start)) {
+        start++;
+    }
+    dfsLambda(start);
+    for (int i = 0; i < graph.getNodeCount(); ++i) {
+        if (isMember(graph, i) && !visit[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
-bool bfs(const Graph& graph, const std::pair<int, int>& objPair) {
-    if (!graph.getNodeCount()) {
+template <typename Network>
+static bool breadthFirst(const Network& graph, const std::pair<int, int>& objPair) {
+    if (!memberCount(graph)) {
         std::cerr << "Cannot search for an empty graph." << std::endl;
         return false;
     }
-    if (objPair.first >= graph.getNodeCount()) {
+    if (!isMember(graph, objPair.first)) {
         std::cerr << "The beginning point " << objPair.first << " is not in this graph with " << graph.getNodeCount() << " node(s)." << std::endl;
         return false;
     }
-    if (objPair.second >= graph.getNodeCount()) {
+    if (!isMember(graph, objPair.second)) {
         std::cerr << "The ending point " << objPair.second << " is not in this graph with " << graph.getNodeCount() << " node(s)." << std::endl;
         return false;
     }
@@ -55,14 +262,29 @@ bool bfs(const Graph& graph, const std::pair<int, int>& objPair) {
     return false;
 }
 
+bool dfs(const Graph& graph) {
+    return depthFirst(graph);
+}
+
+bool dfs(const SubgraphView& view) {
+    return depthFirst(view);
+}
+
+bool bfs(const Graph& graph, const std::pair<int, int>& objPair) {
+    return breadthFirst(graph, objPair);
+}
+
+bool bfs(const SubgraphView& view, const std::pair<int, int>& objPair) {
+    return breadthFirst(view, objPair);
+}
+
 std::vector<std::vector<double>> floyd(const Graph& graph) {
     if (!graph.getNodeCount()) {
         std::cerr << "Cannot apply on an empty graph." << std::endl;
         return std::vector<std::vector<double>>(0);
     }
     const int nc = graph.getNodeCount();
-    constexpr double inf = 1.e150; // DOUBLE_MAX ~ pow(2, 1024) ~ 1.e308, here `inf` * 2. will not exceed it.
-    std::vector<std::vector<double>> distMat(nc, std::vector<double>(nc, inf));
+    std::vector<std::vector<double>> distMat(nc, std::vector<double>(nc, unreachable));
     for (int i = 0; i < nc; ++i) {
         for (auto [destination, distance]: graph.getNeighbors(i)) {
             distMat[i][destination] = distance;
@@ -80,3 +302,234 @@ std::vector<std::vector<double>> floyd(const Graph& graph) {
     }
     return distMat;
 }
+
+/* One row of `floyd` by a single search, unreachable nodes get `unreachable`. `hop` counts edges by BFS (right for unit
+ * weights), otherwise Dijkstra needs non-negative weights. The heap is kept per thread between calls. */
+template <typename Network>
+static void searchRow(const Network& graph, const int source, std::vector<double>& dist, const bool hop) {
+    dist.assign(graph.getNodeCount(), unreachable);
+    if (!isMember(graph, source)) {
+        std::cerr << "The source " << source << " is not in this graph with " << graph.getNodeCount() << " node(s)." << std::endl;
+        return;
+    }
+    dist[source] = 0.;
+    if (hop) {
+        thread_local std::vector<int> queue;
+        queue.assign(1, source);
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const int u = queue[head];
+            for (const auto& [v, weight]: graph.getNeighbors(u)) {
+                if (dist[v] == unreachable) {
+                    dist[v] = dist[u] + 1.;
+                    queue.push_back(v);
+                }
+            }
+        }
+        return;
+    }
+    constexpr auto greater = std::greater<std::pair<double, int>>();
+    thread_local std::vector<std::pair<double, int>> heap;
+    heap.assign(1, {0., source});
+    while (!heap.empty()) {
+        std::ranges::pop_heap(heap, greater);
+        const auto [du, u] = heap.back();
+        heap.pop_back();
+        if (du > dist[u]) {
+            continue; // Stale entry.
+        }
+        for (const auto& [v, weight]: graph.getNeighbors(u)) {
+            if (du + weight < dist[v]) {
+                dist[v] = du + weight;
+                heap.emplace_back(du + weight, v);
+                std::ranges::push_heap(heap, greater);
+            }
+        }
+    }
+}
+
+void distanceRow(const Graph& graph, const int source, std::vector<double>& dist, const bool hop) {
+    searchRow(graph, source, dist, hop);
+}
+
+void distanceRow(const SubgraphView& view, const int source, std::vector<double>& dist, const bool hop) {
+    searchRow(view, source, dist, hop);
+}
+
+std::pair<double, std::vector<int>> bidirectionalBfs(const Graph& graph, const std::pair<int, int>& objPair, const bool withPath) {
+    if (!validPair(graph, objPair)) {
+        return {unreachable, std::vector<int>(0)};
+    }
+    const ReverseGraph reverse(graph);
+    SearchBuffer buffer(graph.getNodeCount());
+    const int meet = searchBfs(graph, reverse, buffer, objPair.first, objPair.second);
+    if (!~meet) {
+        return {unreachable, std::vector<int>(0)};
+    }
+    return {buffer.dist[0][meet] + buffer.dist[1][meet], withPath ? meetPath(buffer, meet) : std::vector<int>(0)};
+}
+
+std::pair<double, std::vector<int>> bidirectionalDijkstra(const Graph& graph, const std::pair<int, int>& objPair, const bool withPath) {
+    if (!validPair(graph, objPair)) {
+        return {unreachable, std::vector<int>(0)};
+    }
+    const ReverseGraph reverse(graph);
+    SearchBuffer buffer(graph.getNodeCount());
+    const int meet = searchDijkstra(graph, reverse, buffer, objPair.first, objPair.second);
+    if (!~meet) {
+        return {unreachable, std::vector<int>(0)};
+    }
+    return {buffer.dist[0][meet] + buffer.dist[1][meet], withPath ? meetPath(buffer, meet) : std::vector<int>(0)};
+}
+
+std::vector<double> batchDistance(const Graph& graph, const std::vector<std::pair<int, int>>& objPairs, const bool weighted) {
+    std::vector<double> ret(objPairs.size(), unreachable);
+    if (!graph.getNodeCount()) {
+        std::cerr << "Cannot search for an empty graph." << std::endl;
+        return ret;
+    }
+    std::vector<char> valid(objPairs.size());
+    for (std::size_t q = 0; q < objPairs.size(); ++q) {
+        valid[q] = validPair(graph, objPairs[q]);
+        if (!valid[q]) {
+            ret[q] = -1.; // Reported above, the other pairs are still answered.
+        }
+    }
+    const ReverseGraph reverse(graph); // Shared read-only by every worker.
+    parallelFor(0, static_cast<int>(objPairs.size()), [&](const int begin, const int end, int) {
+        SearchBuffer buffer(graph.getNodeCount()); // One per worker, reused by all of its queries.
+        for (int q = begin; q < end; ++q) {
+            if (!valid[q]) {
+                continue;
+            }
+            const auto [source, target] = objPairs[q];
+            const int meet = weighted ? searchDijkstra(graph, reverse, buffer, source, target) : searchBfs(graph, reverse, buffer, source, target);
+            if (~meet) {
+                ret[q] = buffer.dist[0][meet] + buffer.dist[1][meet];
+            }
+        }
+    });
+    return ret;
+}
+
+std::vector<double> pageRank(const Graph& graph, const double damping, const std::vector<double>& personalization, const std::vector<double>& initial, const double tolerance, const int maxIteration) {
+    if (!graph.getNodeCount()) {
+        std::cerr << "Cannot apply on an empty graph." << std::endl;
+        return std::vector<double>(0);
+    }
+    if (damping <= 0. || damping >= 1.) {
+        std::cerr << "Damping factor must be in (0, 1), " << damping << " is invalid." << std::endl;
+        return std::vector<double>(0);
+    }
+    const int nc = graph.getNodeCount();
+    if (!personalization.empty() && static_cast<int>(personalization.size()) != nc) {
+        std::cerr << "Personalization vector has " << personalization.size() << " item(s), but the graph has " << nc << " node(s)." << std::endl;
+        return std::vector<double>(0);
+    }
+    std::vector<double> teleport(nc, 1. / nc);
+    if (!personalization.empty()) {
+        double total = 0.;
+        for (const double p: personalization) {
+            total += p > 0. ? p : 0.;
+        }
+        if (total <= 0.) {
+            std::cerr << "Personalization vector has no positive item." << std::endl;
+            return std::vector<double>(0);
+        }
+        for (int i = 0; i < nc; ++i) {
+            teleport[i] = (personalization[i] > 0. ? personalization[i] : 0.) / total;
+        }
+    }
+    /* Pull direction: gather the in-edges of every node into a CSR, so each row only writes its own rank. */
+    std::vector<std::size_t> inOffset(nc + 1, 0);
+    std::vector<double> invOut(nc, 0.);
+    for (int i = 0; i < nc; ++i) {
+        const auto& neighbors = graph.getNeighbors(i);
+        invOut[i] = neighbors.empty() ? 0. : 1. / static_cast<double>(neighbors.size());
+        for (const auto& [destination, weight]: neighbors) {
+            inOffset[destination + 1]++;
+        }
+    }
+    for (int i = 0; i < nc; ++i) {
+        inOffset[i+1] += inOffset[i];
+    }
+    std::vector<int> inSource(inOffset[nc]);
+    std::vector<std::size_t> fill(inOffset.begin(), inOffset.end() - 1);
+    for (int i = 0; i < nc; ++i) {
+        for (const auto& [destination, weight]: graph.getNeighbors(i)) {
+            inSource[fill[destination]++] = i;
+        }
+    }
+    std::vector<double> rank = teleport, next(nc), contribution(nc);
+    if (!initial.empty()) {
+        if (static_cast<int>(initial.size()) > nc) {
+            std::cout << "Warm start has more items (" << initial.size() << ") than node(s) (" << nc << "), start from the teleport vector." << std::endl;
+        } else {
+            const int known = static_cast<int>(initial.size());
+            double total = 0.;
+            for (int i = 0; i < nc; ++i) {
+                rank[i] = i < known ? std::max(initial[i], 0.) : teleport[i]; // Appended nodes start from the teleport vector.
+                total += rank[i];
+            }
+            for (double& r: rank) {
+                r = total > 0. ? r / total : 1. / nc;
+            }
+        }
+    }
+    const int workers = std::min(threadCount(), nc);
+    const std::vector<int> bounds = balancedPartition(inOffset, workers);
+    std::vector<double> partialDangling(workers, 0.), partialDelta(workers, 0.);
+    double dangling = 0.;
+    int iteration = 0;
+    bool finished = false;
+    /* Every worker keeps its own partial sums, they are only reduced once per phase by the barrier completion. */
+    std::barrier danglingSync(workers, [&]() noexcept {
+        dangling = 0.;
+        for (const double d: partialDangling) {
+            dangling += d;
+        }
+    });
+    std::barrier deltaSync(workers, [&]() noexcept {
+        double delta = 0.;
+        for (const double d: partialDelta) {
+            delta += d;
+        }
+        rank.swap(next);
+        iteration++;
+        finished = delta < tolerance || iteration >= maxIteration;
+    });
+    runWorkers(workers, [&](const int t) {
+        const int begin = bounds[t], end = bounds[t+1];
+        while (!finished) {
+            double localDangling = 0.;
+            for (int i = begin; i < end; ++i) {
+                contribution[i] = rank[i] * invOut[i];
+                localDangling += invOut[i] == 0. ? rank[i] : 0.;
+            }
+            partialDangling[t] = localDangling;
+            danglingSync.arrive_and_wait();
+            double localDelta = 0.;
+            const double* source = contribution.data();
+            for (int i = begin; i < end; ++i) {
+                /* Four independent accumulators break the add dependency chain so the gather can be pipelined. */
+                double s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+                std::size_t k = inOffset[i];
+                const std::size_t last = inOffset[i+1];
+                for (; k + 4 <= last; k += 4) {
+                    s0 += source[inSource[k]];
+                    s1 += source[inSource[k+1]];
+                    s2 += source[inSource[k+2]];
+                    s3 += source[inSource[k+3]];
+                }
+                for (; k < last; ++k) {
+                    s0 += source[inSource[k]];
+                }
+                const double value = (1. - damping) * teleport[i] + damping * (s0 + s1 + s2 + s3 + dangling * teleport[i]);
+                localDelta += std::abs(value - rank[i]);
+                next[i] = value;
+            }
+            partialDelta[t] = localDelta;
+            deltaSync.arrive_and_wait();
+        }
+    });
+    return rank;
+}
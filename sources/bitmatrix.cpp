@@ -0,0 +1,169 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <bit>
+
+#include "../headers/bitmatrix.h"
+#include "../headers/algorithm.h"
+#include "../headers/parallel.h"
+
+BitMatrix::BitMatrix() : nodeCount(0), rowWords(0), directed(false) {}
+
+BitMatrix::BitMatrix(const Graph& graph) : BitMatrix() {
+    const int nc = graph.getNodeCount();
+    this->nodeCount = nc;
+    this->rowWords = (nc + 63) / 64;
+    this->directed = graph.isDirected();
+    this->bits.assign(static_cast<std::size_t>(nc) * this->rowWords, 0);
+    parallelFor(0, nc, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            std::uint64_t* bitRow = this->bits.data() + static_cast<std::size_t>(i) * this->rowWords;
+            for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+                bitRow[neighbor >> 6] |= std::uint64_t(1) << (neighbor & 63);
+            }
+        }
+    });
+}
+
+BitMatrix::~BitMatrix() = default;
+
+const std::uint64_t* BitMatrix::row(const int nodeIndex) const {
+    return this->bits.data() + static_cast<std::size_t>(nodeIndex) * this->rowWords;
+}
+
+int BitMatrix::getNodeCount() const {
+    return this->nodeCount;
+}
+
+bool BitMatrix::isDirected() const {
+    return this->directed;
+}
+
+std::size_t BitMatrix::memoryUsage() const {
+    return sizeof(BitMatrix) + this->bits.capacity() * sizeof(std::uint64_t);
+}
+
+bool BitMatrix::hasEdge(const int from, const int to) const {
+    if (from < 0 || from >= this->nodeCount || to < 0 || to >= this->nodeCount) {
+        std::cerr << "Edge [" << from << ", " << to << "] is out of the matrix with " << this->nodeCount << " node(s)." << std::endl;
+        return false;
+    }
+    return this->row(from)[to >> 6] >> (to & 63) & 1;
+}
+
+int BitMatrix::degree(const int nodeIndex) const {
+    if (nodeIndex < 0 || nodeIndex >= this->nodeCount) {
+        std::cerr << "Can not get " << nodeIndex << "th node in " << this->nodeCount << " node(s) matrix." << std::endl;
+        return 0;
+    }
+    const std::uint64_t* bitRow = this->row(nodeIndex);
+    int count = 0;
+    for (int k = 0; k < this->rowWords; ++k) {
+        count += std::popcount(bitRow[k]);
+    }
+    return count;
+}
+
+/* Level-synchronous search on bitsets. A small frontier ORs its rows into the next level (top-down), a large one
+ * of an undirected graph lets every unvisited node look for any frontier bit in its own row instead (bottom-up),
+ * which stops at the first hit and is what makes the levels of a dense graph cheap. */
+void BitMatrix::hopRow(const int source, std::vector<double>& dist) const {
+    dist.assign(this->nodeCount, unreachable);
+    if (source < 0 || source >= this->nodeCount) {
+        std::cerr << "Can not search from " << source << "th node in " << this->nodeCount << " node(s) matrix." << std::endl;
+        return;
+    }
+    const int words = this->rowWords;
+    std::vector<std::uint64_t> visited(words, 0), frontier(words, 0), next(words);
+    if (this->nodeCount & 63) {
+        visited[words - 1] = ~std::uint64_t(0) << (this->nodeCount & 63); // Padding bits never get visited.
+    }
+    visited[source >> 6] |= std::uint64_t(1) << (source & 63);
+    frontier[source >> 6] |= std::uint64_t(1) << (source & 63);
+    dist[source] = 0.;
+    int frontierSize = 1, unvisited = this->nodeCount - 1;
+    for (int level = 1; frontierSize && unvisited; ++level) {
+        std::ranges::fill(next, 0);
+        if (!this->directed && frontierSize * 16 >= unvisited) {
+            for (int w = 0; w < words; ++w) {
+                for (std::uint64_t open = ~visited[w]; open; open &= open - 1) {
+                    const std::uint64_t* bitRow = this->row(w * 64 + std::countr_zero(open));
+                    for (int k = 0; k < words; ++k) {
+                        if (bitRow[k] & frontier[k]) {
+                            next[w] |= open & -open;
+                            break;
+                        }
+                    }
+                }
+            }
+        } else {
+            for (int w = 0; w < words; ++w) {
+                for (std::uint64_t active = frontier[w]; active; active &= active - 1) {
+                    const std::uint64_t* bitRow = this->row(w * 64 + std::countr_zero(active));
+                    for (int k = 0; k < words; ++k) {
+                        next[k] |= bitRow[k];
+                    }
+                }
+            }
+            for (int k = 0; k < words; ++k) {
+                next[k] &= ~visited[k];
+            }
+        }
+        frontierSize = 0;
+        for (int w = 0; w < words; ++w) {
+            visited[w] |= next[w];
+            frontierSize += std::popcount(next[w]);
+            for (std::uint64_t found = next[w]; found; found &= found - 1) {
+                dist[w * 64 + std::countr_zero(found)] = level;
+            }
+        }
+        unvisited -= frontierSize;
+        frontier.swap(next);
+    }
+}
+
+/* Triangles through every node of an undirected graph. Node i meets each of its triangles twice, once from either
+ * other corner j, as a common neighbor of rows i and j; self-loops put i and j into their own rows and are taken out. */
+std::vector<long long> BitMatrix::triangles() const {
+    if (this->directed) {
+        std::cerr << "Undefined triangles for unidirected network." << std::endl;
+        return std::vector<long long>(0);
+    }
+    std::vector<long long> ret(this->nodeCount, 0);
+    parallelFor(0, this->nodeCount, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            const std::uint64_t* rowI = this->row(i);
+            const bool loopI = rowI[i >> 6] >> (i & 63) & 1;
+            long long twice = 0;
+            for (int w = 0; w < this->rowWords; ++w) {
+                for (std::uint64_t neighbors = rowI[w]; neighbors; neighbors &= neighbors - 1) {
+                    const int j = w * 64 + std::countr_zero(neighbors);
+                    if (j == i) {
+                        continue;
+                    }
+                    const std::uint64_t* rowJ = this->row(j);
+                    long long common = -static_cast<long long>(loopI) - static_cast<long long>(rowJ[j >> 6] >> (j & 63) & 1);
+                    for (int k = 0; k < this->rowWords; ++k) {
+                        common += std::popcount(rowI[k] & rowJ[k]);
+                    }
+                    twice += common;
+                }
+            }
+            ret[i] = twice / 2;
+        }
+    });
+    return ret;
+}
+
+bool isDense(const Graph& graph) {
+    const int nc = graph.getNodeCount();
+    if (nc < 64) {
+        return false; // A single word row, nothing to gain over the lists.
+    }
+    std::size_t entries = 0;
+    for (int i = 0; i < nc; ++i) {
+        entries += graph.getNeighbors(i).size();
+    }
+    return static_cast<double>(entries) >= denseThreshold * nc * (nc - 1.);
+}
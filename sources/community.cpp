@@ -0,0 +1,314 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include "../headers/community.h"
+#include "../headers/parallel.h"
+
+namespace {
+    /* One Louvain level as a symmetric CSR, self-loops are kept aside and already counted twice (A_ii). */
+    struct Level {
+        int nodeCount = 0;
+        std::vector<std::size_t> offset;
+        std::vector<int> target;
+        std::vector<double> weight, loop, strength;
+        double totalWeight = 0.; // 2m, i.e. sum of all strengths.
+    };
+}
+
+static bool buildLevel(const Graph& graph, Level& level) {
+    const int nodeCount = graph.getNodeCount();
+    level.nodeCount = nodeCount;
+    level.offset.assign(nodeCount + 1, 0);
+    level.loop.assign(nodeCount, 0.);
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (weight <= 0.) {
+                std::cerr << "Modularity needs positive edge weights, edge [" << i << ", " << neighbor << "] is weighted by " << weight << "." << std::endl;
+                return false;
+            }
+            if (neighbor == i) {
+                level.loop[i] += graph.isDirected() ? 2. * weight : weight; // Undirected self-loop weight has been added twice.
+                continue;
+            }
+            level.offset[i + 1]++;
+            if (graph.isDirected()) {
+                level.offset[neighbor + 1]++;
+            }
+        }
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        level.offset[i + 1] += level.offset[i];
+    }
+    level.target.resize(level.offset[nodeCount]);
+    level.weight.resize(level.offset[nodeCount]);
+    std::vector<std::size_t> fill(level.offset.begin(), level.offset.end() - 1);
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (neighbor == i) {
+                continue;
+            }
+            level.target[fill[i]] = neighbor;
+            level.weight[fill[i]++] = weight;
+            if (graph.isDirected()) {
+                level.target[fill[neighbor]] = i;
+                level.weight[fill[neighbor]++] = weight;
+            }
+        }
+    }
+    level.strength.assign(nodeCount, 0.);
+    parallelFor(0, nodeCount, [&level](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            double strength = level.loop[i];
+            for (std::size_t k = level.offset[i]; k < level.offset[i + 1]; ++k) {
+                strength += level.weight[k];
+            }
+            level.strength[i] = strength;
+        }
+    });
+    level.totalWeight = 0.;
+    for (const double strength: level.strength) {
+        level.totalWeight += strength;
+    }
+    return true;
+}
+
+static double levelModularity(const Level& level, const std::vector<int>& community) {
+    const int workers = std::max(1, std::min(threadCount(), level.nodeCount));
+    std::vector<double> partialIn(workers, 0.), tot(level.nodeCount, 0.);
+    parallelFor(0, level.nodeCount, [&](const int begin, const int end, const int t) {
+        double in = 0.;
+        for (int i = begin; i < end; ++i) {
+            in += level.loop[i];
+            for (std::size_t k = level.offset[i]; k < level.offset[i + 1]; ++k) {
+                in += community[level.target[k]] == community[i] ? level.weight[k] : 0.;
+            }
+        }
+        partialIn[t] = in;
+    });
+    for (int i = 0; i < level.nodeCount; ++i) {
+        tot[community[i]] += level.strength[i];
+    }
+    double in = 0., expected = 0.;
+    for (const double p: partialIn) {
+        in += p;
+    }
+    for (const double t: tot) {
+        expected += t * t;
+    }
+    return in / level.totalWeight - expected / level.totalWeight / level.totalWeight;
+}
+
+/* Synchronous local moving: every sweep decides the moves of one id parity class from the same snapshot, so the
+ * result does not depend on the thread count and neighbors rarely move past each other. A singleton only joins
+ * another singleton with a smaller id, to avoid swapping. */
+static std::vector<int> moveNodes(const Level& level, const double tolerance) {
+    const int nodeCount = level.nodeCount;
+    std::vector<int> community(nodeCount), next(nodeCount), size(nodeCount, 1);
+    std::vector<double> tot = level.strength;
+    for (int i = 0; i < nodeCount; ++i) {
+        community[i] = i;
+    }
+    const int workers = std::max(1, std::min(threadCount(), nodeCount));
+    std::vector<std::vector<double>> weightTo(workers);
+    double quality = levelModularity(level, community);
+    int idle = 0;
+    for (int sweep = 0; sweep < 128; ++sweep) {
+        parallelFor(0, nodeCount, [&](const int begin, const int end, const int t) {
+            std::vector<double>& link = weightTo[t];
+            link.resize(nodeCount, 0.); // Touched entries are reset after use, so it stays zero between sweeps.
+            std::vector<int> touched;
+            for (int i = begin; i < end; ++i) {
+                const int own = community[i];
+                if ((i + sweep) & 1) {
+                    next[i] = own;
+                    continue;
+                }
+                const double ki = level.strength[i];
+                for (std::size_t k = level.offset[i]; k < level.offset[i + 1]; ++k) {
+                    const int c = community[level.target[k]];
+                    if (link[c] == 0.) {
+                        touched.push_back(c);
+                    }
+                    link[c] += level.weight[k];
+                }
+                int best = own;
+                double bestGain = link[own] - (tot[own] - ki) * ki / level.totalWeight;
+                for (const int c: touched) {
+                    const double gain = link[c] - tot[c] * ki / level.totalWeight;
+                    if (c != own && (gain > bestGain || (gain == bestGain && c < best))) {
+                        best = c;
+                        bestGain = gain;
+                    }
+                }
+                if (size[own] == 1 && size[best] == 1 && best > own) {
+                    best = own;
+                }
+                next[i] = best;
+                for (const int c: touched) {
+                    link[c] = 0.;
+                }
+                touched.clear();
+            }
+        });
+        if (next == community) {
+            if (++idle == 2) {
+                break; // Neither parity class wants to move.
+            }
+            continue;
+        }
+        idle = 0;
+        std::vector<int> previous = community;
+        community.swap(next);
+        std::ranges::fill(tot, 0.);
+        std::ranges::fill(size, 0);
+        for (int i = 0; i < nodeCount; ++i) {
+            tot[community[i]] += level.strength[i];
+            size[community[i]]++;
+        }
+        const double updated = levelModularity(level, community);
+        if (updated - quality < tolerance) {
+            if (updated < quality) {
+                community.swap(previous); // Simultaneous moves may conflict, keep the better snapshot.
+            }
+            break;
+        }
+        quality = updated;
+    }
+    return community;
+}
+
+static Level aggregate(const Level& level, const std::vector<int>& community, const int communityCount) {
+    Level coarse;
+    coarse.nodeCount = communityCount;
+    coarse.totalWeight = level.totalWeight;
+    /* Members of every community, grouped by counting sort. */
+    std::vector<int> memberOffset(communityCount + 1, 0), member(level.nodeCount);
+    for (int i = 0; i < level.nodeCount; ++i) {
+        memberOffset[community[i] + 1]++;
+    }
+    for (int c = 0; c < communityCount; ++c) {
+        memberOffset[c + 1] += memberOffset[c];
+    }
+    std::vector<int> fill(memberOffset.begin(), memberOffset.end() - 1);
+    for (int i = 0; i < level.nodeCount; ++i) {
+        member[fill[community[i]]++] = i;
+    }
+    coarse.offset.assign(communityCount + 1, 0);
+    coarse.loop.assign(communityCount, 0.);
+    coarse.strength.assign(communityCount, 0.);
+    const int workers = std::max(1, std::min(threadCount(), communityCount));
+    std::vector<std::vector<double>> weightTo(workers);
+    /* Two passes over the same rows: count distinct neighbor communities, then write them into the contiguous CSR. */
+    for (int pass = 0; pass < 2; ++pass) {
+        if (pass) {
+            for (int c = 0; c < communityCount; ++c) {
+                coarse.offset[c + 1] += coarse.offset[c];
+            }
+            coarse.target.resize(coarse.offset[communityCount]);
+            coarse.weight.resize(coarse.offset[communityCount]);
+        }
+        parallelFor(0, communityCount, [&](const int begin, const int end, const int t) {
+            std::vector<double>& link = weightTo[t];
+            link.assign(communityCount, 0.);
+            std::vector<int> touched;
+            for (int c = begin; c < end; ++c) {
+                double loop = 0., strength = 0.;
+                for (int m = memberOffset[c]; m < memberOffset[c + 1]; ++m) {
+                    const int i = member[m];
+                    loop += level.loop[i];
+                    strength += level.strength[i];
+                    for (std::size_t k = level.offset[i]; k < level.offset[i + 1]; ++k) {
+                        const int d = community[level.target[k]];
+                        if (d == c) {
+                            loop += level.weight[k];
+                            continue;
+                        }
+                        if (link[d] == 0.) {
+                            touched.push_back(d);
+                        }
+                        link[d] += level.weight[k];
+                    }
+                }
+                if (!pass) {
+                    coarse.offset[c + 1] = touched.size();
+                    coarse.loop[c] = loop;
+                    coarse.strength[c] = strength;
+                } else {
+                    std::ranges::sort(touched);
+                    std::size_t k = coarse.offset[c];
+                    for (const int d: touched) {
+                        coarse.target[k] = d;
+                        coarse.weight[k++] = link[d];
+                    }
+                }
+                for (const int d: touched) {
+                    link[d] = 0.;
+                }
+                touched.clear();
+            }
+        });
+    }
+    return coarse;
+}
+
+double modularity(const Graph& graph, const std::vector<int>& community) {
+    if (static_cast<int>(community.size()) != graph.getNodeCount()) {
+        std::cerr << "Community list has " << community.size() << " item(s), but the graph has " << graph.getNodeCount() << " node(s)." << std::endl;
+        return 0.;
+    }
+    if (std::ranges::any_of(community, [&graph](const int c) { return c < 0 || c >= graph.getNodeCount(); })) {
+        std::cerr << "Community id must be in [0, " << graph.getNodeCount() << ")." << std::endl;
+        return 0.;
+    }
+    Level level;
+    if (!buildLevel(graph, level) || level.totalWeight <= 0.) {
+        return 0.;
+    }
+    return levelModularity(level, community);
+}
+
+std::pair<double, std::vector<int>> louvain(const Graph& graph, const int passes, const double tolerance) {
+    if (!graph.getNodeCount()) {
+        std::cerr << "Cannot detect community for an empty graph." << std::endl;
+        return {0., std::vector<int>(0)};
+    }
+    if (graph.isDirected()) {
+        std::cout << "For unidirected network, edge direction is ignored in community detection." << std::endl;
+    }
+    Level level;
+    if (!buildLevel(graph, level)) {
+        return {0., std::vector<int>(0)};
+    }
+    std::vector<int> membership(graph.getNodeCount());
+    for (int i = 0; i < graph.getNodeCount(); ++i) {
+        membership[i] = i;
+    }
+    if (level.totalWeight <= 0.) {
+        return {0., membership}; // Without edges every node is its own community.
+    }
+    for (int pass = 0; passes <= 0 || pass < passes; ++pass) {
+        const std::vector<int> community = moveNodes(level, tolerance);
+        std::vector<int> renumber(level.nodeCount, -1);
+        int communityCount = 0;
+        for (int i = 0; i < level.nodeCount; ++i) {
+            if (!~renumber[community[i]]) {
+                renumber[community[i]] = communityCount++;
+            }
+        }
+        if (communityCount == level.nodeCount) {
+            break; // No node moved, the hierarchy is finished.
+        }
+        std::vector<int> compact(level.nodeCount);
+        for (int i = 0; i < level.nodeCount; ++i) {
+            compact[i] = renumber[community[i]];
+        }
+        for (int& m: membership) {
+            m = compact[m];
+        }
+        level = aggregate(level, compact, communityCount);
+    }
+    Level origin;
+    buildLevel(graph, origin);
+    return {levelModularity(origin, membership), membership};
+}
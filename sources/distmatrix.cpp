@@ -0,0 +1,200 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "../headers/distmatrix.h"
+#include "../headers/algorithm.h"
+#include "../headers/bitmatrix.h"
+#include "../headers/parallel.h"
+
+static constexpr char matrixMagic[8] = {'G', 'E', 'D', 'I', 'S', 'T', '1', '\0'};
+
+/* Largest value of an entry of `width` bytes is kept for unreachable pairs. */
+static std::uint64_t sentinel(const int width) {
+    return width == 8 ? 0 : (std::uint64_t(1) << (8 * width)) - 1;
+}
+
+template <typename Entry>
+static void store(unsigned char* base, const std::size_t slot, const Entry value) {
+    std::memcpy(base + slot * sizeof(Entry), &value, sizeof(Entry));
+}
+
+static void storeHop(unsigned char* base, const int width, const std::size_t slot, const std::uint64_t value) {
+    switch (width) {
+        case 1:
+            store(base, slot, static_cast<std::uint8_t>(value));
+            break;
+        case 2:
+            store(base, slot, static_cast<std::uint16_t>(value));
+            break;
+        default:
+            store(base, slot, static_cast<std::uint32_t>(value));
+    }
+}
+
+DistanceMatrix::DistanceMatrix() : nodeCount(0), width(8), triangular(false) {}
+
+DistanceMatrix::DistanceMatrix(const Graph& graph) : DistanceMatrix() {
+    const int nc = graph.getNodeCount();
+    bool hop = true, negative = false;
+    for (int i = 0; i < nc; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            hop = hop && weight == 1.;
+            negative = negative || weight < 0.;
+        }
+    }
+    this->nodeCount = nc;
+    this->triangular = !graph.isDirected();
+    const std::size_t entries = this->triangular ? static_cast<std::size_t>(nc) * (nc + 1) / 2 : static_cast<std::size_t>(nc) * nc;
+    if (negative) {
+        /* Dijkstra cannot handle it, the full Floyd Warshall matrix is packed instead. */
+        const std::vector<std::vector<double>> matrix = floyd(graph);
+        this->data.resize(entries * sizeof(double));
+        for (int i = 0; i < nc; ++i) {
+            for (int j = 0; j <= (this->triangular ? i : nc - 1); ++j) {
+                store(this->data.data(), this->slot(i, j), matrix[i][j]);
+            }
+        }
+        return;
+    }
+    /* Hops are bounded by nc - 1, rows are searched with that width and shrunk afterwards if the diameter allows. */
+    this->width = !hop ? 8 : nc <= 0xFF ? 1 : nc <= 0xFFFF ? 2 : 4;
+    this->data.resize(entries * this->width);
+    const bool dense = hop && isDense(graph); // Hop rows of a dense graph are searched on its bit rows.
+    const BitMatrix bits = dense ? BitMatrix(graph) : BitMatrix();
+    const int workers = std::max(1, std::min(threadCount(), nc));
+    std::vector<std::uint64_t> longest(workers, 0);
+    parallelFor(0, nc, [&](const int begin, const int end, const int t) {
+        std::vector<double> dist;
+        for (int i = begin; i < end; ++i) {
+            if (dense) {
+                bits.hopRow(i, dist);
+            } else {
+                distanceRow(graph, i, dist, hop);
+            }
+            for (int j = 0; j <= (this->triangular ? i : nc - 1); ++j) {
+                if (!hop) {
+                    store(this->data.data(), this->slot(i, j), dist[j]);
+                } else if (dist[j] == unreachable) {
+                    storeHop(this->data.data(), this->width, this->slot(i, j), sentinel(this->width));
+                } else {
+                    longest[t] = std::max(longest[t], static_cast<std::uint64_t>(dist[j]));
+                    storeHop(this->data.data(), this->width, this->slot(i, j), static_cast<std::uint64_t>(dist[j]));
+                }
+            }
+        }
+    });
+    if (!hop) {
+        return;
+    }
+    const std::uint64_t diameter = *std::ranges::max_element(longest);
+    const int narrow = diameter < sentinel(1) ? 1 : diameter < sentinel(2) ? 2 : 4;
+    if (narrow == this->width) {
+        return;
+    }
+    std::vector<unsigned char> packed(entries * narrow);
+    parallelFor(0, static_cast<int>((entries + 4095) / 4096), [&](const int begin, const int end, int) {
+        for (std::size_t k = static_cast<std::size_t>(begin) * 4096; k < std::min(entries, static_cast<std::size_t>(end) * 4096); ++k) {
+            std::uint64_t value = 0;
+            std::memcpy(&value, this->data.data() + k * this->width, this->width); // Little-endian, the low bytes hold it.
+            storeHop(packed.data(), narrow, k, value == sentinel(this->width) ? sentinel(narrow) : value);
+        }
+    });
+    this->data.swap(packed);
+    this->width = narrow;
+}
+
+DistanceMatrix::DistanceMatrix(const std::string& fileName) : DistanceMatrix() {
+    std::ifstream ifs(fileName, std::ios::binary);
+    if (!ifs.is_open()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return;
+    }
+    char magic[8];
+    int nc = 0, w = 0, tri = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&nc), sizeof(nc));
+    ifs.read(reinterpret_cast<char*>(&w), sizeof(w));
+    ifs.read(reinterpret_cast<char*>(&tri), sizeof(tri));
+    if (!ifs || std::memcmp(magic, matrixMagic, sizeof(magic)) != 0 || nc < 0 || (w != 1 && w != 2 && w != 4 && w != 8)) {
+        std::cerr << "File " << fileName << " is not a distance matrix." << std::endl;
+        return;
+    }
+    const std::uintmax_t entries = tri ? static_cast<std::uintmax_t>(nc) * (nc + 1) / 2 : static_cast<std::uintmax_t>(nc) * nc;
+    if (std::filesystem::file_size(fileName) != sizeof(magic) + 3 * sizeof(int) + entries * w) {
+        std::cerr << "Distance matrix " << fileName << " is truncated or broken." << std::endl;
+        return;
+    }
+    this->data.resize(entries * w);
+    ifs.read(reinterpret_cast<char*>(this->data.data()), static_cast<std::streamsize>(this->data.size()));
+    if (!ifs) {
+        this->data.clear();
+        std::cerr << "Distance matrix " << fileName << " is truncated or broken." << std::endl;
+        return;
+    }
+    this->nodeCount = nc;
+    this->width = w;
+    this->triangular = tri != 0;
+}
+
+DistanceMatrix::~DistanceMatrix() = default;
+
+std::size_t DistanceMatrix::slot(const int source, const int target) const {
+    if (!this->triangular) {
+        return static_cast<std::size_t>(source) * this->nodeCount + target;
+    }
+    const std::size_t high = std::max(source, target), low = std::min(source, target);
+    return high * (high + 1) / 2 + low;
+}
+
+int DistanceMatrix::getNodeCount() const {
+    return this->nodeCount;
+}
+
+int DistanceMatrix::getWidth() const {
+    return this->width;
+}
+
+bool DistanceMatrix::isTriangular() const {
+    return this->triangular;
+}
+
+std::size_t DistanceMatrix::memoryUsage() const {
+    return sizeof(DistanceMatrix) + this->data.capacity();
+}
+
+double DistanceMatrix::at(const int source, const int target) const {
+    if (source < 0 || source >= this->nodeCount || target < 0 || target >= this->nodeCount) {
+        std::cerr << "Cannot get distance of [" << source << ", " << target << "] in matrix with " << this->nodeCount << " node(s)." << std::endl;
+        return unreachable;
+    }
+    const std::size_t k = this->slot(source, target);
+    const unsigned char* base = this->data.data() + k * this->width;
+    if (this->width == 8) {
+        double value;
+        std::memcpy(&value, base, sizeof(value));
+        return value;
+    }
+    std::uint64_t value = 0;
+    std::memcpy(&value, base, this->width);
+    return value == sentinel(this->width) ? unreachable : static_cast<double>(value);
+}
+
+bool DistanceMatrix::save(const std::string& fileName) const {
+    std::ofstream ofs(fileName, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << fileName << " to save the distance matrix." << std::endl;
+        return false;
+    }
+    const int tri = this->triangular;
+    ofs.write(matrixMagic, sizeof(matrixMagic));
+    ofs.write(reinterpret_cast<const char*>(&this->nodeCount), sizeof(this->nodeCount));
+    ofs.write(reinterpret_cast<const char*>(&this->width), sizeof(this->width));
+    ofs.write(reinterpret_cast<const char*>(&tri), sizeof(tri));
+    ofs.write(reinterpret_cast<const char*>(this->data.data()), static_cast<std::streamsize>(this->data.size()));
+    return static_cast<bool>(ofs);
+}
@@ -0,0 +1,213 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <queue>
+
+#include "../headers/edgefile.h"
+
+static constexpr char edgeFileMagic[8] = {'G', 'E', 'E', 'D', 'G', 'E', 'S', '1'};
+static constexpr std::size_t edgeFileHeader = sizeof(edgeFileMagic) + 2 * sizeof(int) + sizeof(long long);
+
+EdgeFileWriter::EdgeFileWriter(std::string fileName, const std::size_t memoryEdges) : fileName(std::move(fileName)), memoryEdges(std::max<std::size_t>(memoryEdges, 1)), nodeCount(0), directed(false), failed(false) {}
+
+EdgeFileWriter::~EdgeFileWriter() {
+    for (const std::string& run: this->runs) {
+        std::error_code ec;
+        std::filesystem::remove(run, ec);
+    }
+}
+
+void EdgeFileWriter::setNodeCount(const int count, const bool isDirected) {
+    this->nodeCount = count;
+    this->directed = isDirected;
+}
+
+int EdgeFileWriter::getNodeCount() const {
+    return this->nodeCount;
+}
+
+void EdgeFileWriter::add(const std::vector<std::tuple<int, int, double>>& edges) {
+    for (const auto& [left, right, weight]: edges) {
+        if (left < 0 || left >= this->nodeCount || right < 0 || right >= this->nodeCount) {
+            std::cerr << "Edge [" << left << ", " << right << "] is out of the streamed graph with " << this->nodeCount << " node(s)." << std::endl;
+            continue;
+        }
+        if (!this->directed && left > right) {
+            this->buffer.push_back({right, left, weight});
+        } else {
+            this->buffer.push_back({left, right, weight});
+        }
+        if (this->buffer.size() >= this->memoryEdges) {
+            this->failed = !this->spill() || this->failed;
+        }
+    }
+}
+
+/* Sorts the buffer, merges repeated edges and writes it as one run. */
+bool EdgeFileWriter::spill() {
+    std::ranges::sort(this->buffer, [](const Record& left, const Record& right) {
+        return left.left != right.left ? left.left < right.left : left.right < right.right;
+    });
+    std::size_t kept = 0;
+    for (std::size_t k = 0; k < this->buffer.size(); ++k) {
+        if (kept && this->buffer[kept - 1].left == this->buffer[k].left && this->buffer[kept - 1].right == this->buffer[k].right) {
+            this->buffer[kept - 1].weight += this->buffer[k].weight;
+        } else {
+            this->buffer[kept++] = this->buffer[k];
+        }
+    }
+    const std::string run = this->fileName + ".run" + std::to_string(this->runs.size());
+    std::ofstream ofs(run, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << run << " to spill sorted edges." << std::endl;
+        this->buffer.clear();
+        return false;
+    }
+    this->runs.push_back(run);
+    ofs.write(reinterpret_cast<const char*>(this->buffer.data()), static_cast<std::streamsize>(kept * sizeof(Record)));
+    this->buffer.clear();
+    return static_cast<bool>(ofs);
+}
+
+long long EdgeFileWriter::finish() {
+    if (!this->buffer.empty() && !this->spill()) {
+        this->failed = true;
+    }
+    if (this->failed) {
+        std::cerr << "Streaming into " << this->fileName << " failed, some sorted runs are missing." << std::endl;
+        return -1;
+    }
+    std::ofstream ofs(this->fileName, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << this->fileName << " to write the edge file." << std::endl;
+        return -1;
+    }
+    const int flag = this->directed;
+    long long edgeCount = 0;
+    ofs.write(edgeFileMagic, sizeof(edgeFileMagic));
+    ofs.write(reinterpret_cast<const char*>(&this->nodeCount), sizeof(this->nodeCount));
+    ofs.write(reinterpret_cast<const char*>(&flag), sizeof(flag));
+    ofs.write(reinterpret_cast<const char*>(&edgeCount), sizeof(edgeCount)); // Patched after the merge.
+    /* K-way merge, every run is read through a small block so memory stays bounded by the run count. */
+    constexpr std::size_t block = 1 << 16;
+    struct Cursor {
+        std::ifstream ifs;
+        std::vector<Record> records;
+        std::size_t next = 0;
+    };
+    std::vector<Cursor> cursors(this->runs.size());
+    const auto refill = [&cursors](const std::size_t r) {
+        Cursor& cursor = cursors[r];
+        cursor.records.resize(block);
+        cursor.ifs.read(reinterpret_cast<char*>(cursor.records.data()), static_cast<std::streamsize>(block * sizeof(Record)));
+        cursor.records.resize(static_cast<std::size_t>(cursor.ifs.gcount()) / sizeof(Record));
+        cursor.next = 0;
+        return !cursor.records.empty();
+    };
+    const auto later = [&cursors](const std::size_t left, const std::size_t right) {
+        const Record& l = cursors[left].records[cursors[left].next];
+        const Record& r = cursors[right].records[cursors[right].next];
+        return l.left != r.left ? l.left > r.left : l.right > r.right;
+    };
+    std::priority_queue<std::size_t, std::vector<std::size_t>, decltype(later)> heap(later);
+    for (std::size_t r = 0; r < cursors.size(); ++r) {
+        cursors[r].ifs.open(this->runs[r], std::ios::binary);
+        if (refill(r)) {
+            heap.push(r);
+        }
+    }
+    std::vector<Record> out;
+    out.reserve(block);
+    Record last{-1, -1, 0.};
+    const auto flush = [&ofs, &out]() {
+        ofs.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size() * sizeof(Record)));
+        out.clear();
+    };
+    while (!heap.empty()) {
+        const std::size_t r = heap.top();
+        heap.pop();
+        const Record record = cursors[r].records[cursors[r].next++];
+        if (cursors[r].next < cursors[r].records.size() || refill(r)) {
+            heap.push(r);
+        }
+        if (record.left == last.left && record.right == last.right) {
+            last.weight += record.weight; // Same edge spilled in different runs.
+            continue;
+        }
+        if (~last.left) {
+            out.push_back(last);
+            edgeCount++;
+            if (out.size() == block) {
+                flush();
+            }
+        }
+        last = record;
+    }
+    if (~last.left) {
+        out.push_back(last);
+        edgeCount++;
+    }
+    flush();
+    ofs.seekp(static_cast<std::streamoff>(edgeFileHeader - sizeof(edgeCount)));
+    ofs.write(reinterpret_cast<const char*>(&edgeCount), sizeof(edgeCount));
+    cursors.clear();
+    for (const std::string& run: this->runs) {
+        std::error_code ec;
+        std::filesystem::remove(run, ec);
+    }
+    this->runs.clear();
+    if (!ofs) {
+        std::cerr << "Writing the edge file " << this->fileName << " failed." << std::endl;
+        return -1;
+    }
+    return edgeCount;
+}
+
+Graph readEdgeFile(const std::string& fileName) {
+    std::ifstream ifs(fileName, std::ios::binary);
+    if (!ifs.is_open()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return Graph();
+    }
+    char magic[8];
+    int nodeCount = 0, flag = 0;
+    long long edgeCount = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&nodeCount), sizeof(nodeCount));
+    ifs.read(reinterpret_cast<char*>(&flag), sizeof(flag));
+    ifs.read(reinterpret_cast<char*>(&edgeCount), sizeof(edgeCount));
+    if (!ifs || std::memcmp(magic, edgeFileMagic, sizeof(magic)) != 0 || nodeCount < 0 || edgeCount < 0) {
+        std::cerr << "File " << fileName << " is not an edge file." << std::endl;
+        return Graph();
+    }
+    if (std::filesystem::file_size(fileName) != edgeFileHeader + static_cast<std::uintmax_t>(edgeCount) * (2 * sizeof(int) + sizeof(double))) {
+        std::cerr << "Edge file " << fileName << " is truncated or broken." << std::endl;
+        return Graph();
+    }
+    if (edgeCount > INT_MAX) {
+        std::cerr << "Edge file " << fileName << " has " << edgeCount << " edges, too many to load into memory as one graph." << std::endl;
+        return Graph();
+    }
+    std::vector<std::tuple<int, int, double>> edges;
+    edges.reserve(edgeCount);
+    std::vector<char> block(static_cast<std::size_t>(1 << 16) * 16);
+    for (long long done = 0; done < edgeCount; ) {
+        const long long count = std::min<long long>(edgeCount - done, 1 << 16);
+        ifs.read(block.data(), static_cast<std::streamsize>(count * 16));
+        for (long long k = 0; k < count; ++k) {
+            int left, right;
+            double weight;
+            std::memcpy(&left, block.data() + k * 16, sizeof(int));
+            std::memcpy(&right, block.data() + k * 16 + 4, sizeof(int));
+            std::memcpy(&weight, block.data() + k * 16 + 8, sizeof(double));
+            edges.emplace_back(left, right, weight);
+        }
+        done += count;
+    }
+    return {nodeCount, edges, flag != 0};
+}
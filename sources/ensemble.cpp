@@ -0,0 +1,207 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <cmath>
+#include <fstream>
+#include <map>
+
+#include "../headers/ensemble.h"
+#include "../headers/algorithm.h"
+#include "../headers/community.h"
+#include "../headers/parallel.h"
+#include "../headers/rng.h"
+#include "../headers/stats.h"
+
+namespace {
+    /* Running mean and squared deviation (Welford), two of them merge exactly (Chan et al.). */
+    struct Moment {
+        long long count = 0;
+        double mean = 0., m2 = 0.;
+
+        void add(const double value) {
+            count++;
+            const double delta = value - mean;
+            mean += delta / static_cast<double>(count);
+            m2 += delta * (value - mean);
+        }
+
+        void merge(const Moment& other) {
+            if (!other.count) {
+                return;
+            }
+            const long long total = count + other.count;
+            const double delta = other.mean - mean;
+            mean += delta * static_cast<double>(other.count) / static_cast<double>(total);
+            m2 += other.m2 + delta * delta * static_cast<double>(count) * static_cast<double>(other.count) / static_cast<double>(total);
+            count = total;
+        }
+    };
+
+    struct Accumulator {
+        std::map<std::string, Moment> scalar;
+        std::vector<Moment> distribution; // Only degrees that appeared, the missing zeros are added at the end.
+        long long samples = 0;
+    };
+
+    /* What a worker keeps between its seeds: the slot of its current graph and one distance row. */
+    struct Worker {
+        Graph graph;
+        std::vector<double> dist;
+    };
+}
+
+static constexpr int ensembleStripes = 64;
+static const std::vector<std::string> knownStatistics = {"size", "degree", "cluster", "distance", "core", "community"};
+
+/* Two-sided 97.5% quantile of Student's t for 1 to 30 degrees of freedom, the normal one after that. */
+static double criticalValue(const long long freedom) {
+    static constexpr double table[30] = {12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228, 2.201, 2.179, 2.160, 2.145, 2.131,
+                                         2.120, 2.110, 2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042};
+    return freedom >= 1 && freedom <= 30 ? table[freedom - 1] : 1.960;
+}
+
+/* Same as `distance(graph)`, but row by row into the worker's buffer instead of a matrix of every pair per graph. */
+static std::tuple<double, double, double> rowDistance(const Graph& graph, std::vector<double>& dist) {
+    const int nodeCount = graph.getNodeCount();
+    bool hop = true;
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (weight < 0.) {
+                return distance(graph); // Only Floyd Warshall handles it.
+            }
+            hop = hop && weight == 1.;
+        }
+    }
+    long long count = 0;
+    double min = unreachable, max = -unreachable, mean = 0.;
+    for (int i = 0; i < nodeCount; ++i) {
+        distanceRow(graph, i, dist, hop);
+        for (int j = 0; j < nodeCount; ++j) {
+            if (i == j || dist[j] == unreachable) {
+                continue;
+            }
+            min = std::min(min, dist[j]);
+            max = std::max(max, dist[j]);
+            mean += dist[j];
+            count++;
+        }
+    }
+    if (!count) {
+        return {0., 0., 0.};
+    }
+    return {min, mean / static_cast<double>(count), max};
+}
+
+static void measure(Worker& worker, const std::vector<std::string>& statistics, Accumulator& accumulator) {
+    const Graph& graph = worker.graph;
+    accumulator.samples++;
+    for (const std::string& statistic: statistics) {
+        if (statistic == "size") {
+            accumulator.scalar["nodeCount"].add(graph.getNodeCount());
+            accumulator.scalar["edgeCount"].add(graph.getEdgeCount());
+        } else if (statistic == "degree") {
+            const auto [moments, distribution] = degreeDistribution(graph);
+            accumulator.scalar["averageDegree"].add(moments.first);
+            accumulator.scalar["varianceDegree"].add(moments.second);
+            if (accumulator.distribution.size() < distribution.size()) {
+                accumulator.distribution.resize(distribution.size());
+            }
+            for (std::size_t k = 0; k < distribution.size(); ++k) {
+                if (distribution[k] > 0.) {
+                    accumulator.distribution[k].add(distribution[k]);
+                }
+            }
+        } else if (statistic == "cluster") {
+            accumulator.scalar["clusterCoefficient"].add(clusterCoefficient(graph));
+        } else if (statistic == "distance") {
+            const auto [minimum, average, maximum] = rowDistance(graph, worker.dist);
+            accumulator.scalar["minimumDistance"].add(minimum);
+            accumulator.scalar["averageDistance"].add(average);
+            accumulator.scalar["maximumDistance"].add(maximum);
+        } else if (statistic == "core") {
+            accumulator.scalar["degeneracy"].add(coreNumber(graph).first);
+        } else if (statistic == "community") {
+            const auto [mod, com] = louvain(graph);
+            accumulator.scalar["communityCount"].add(com.empty() ? 0 : *std::ranges::max_element(com) + 1);
+            accumulator.scalar["modularity"].add(mod);
+        }
+    }
+}
+
+static EnsembleRow summary(const std::string& statistic, const int key, const Moment& moment) {
+    const double variance = moment.count > 1 ? moment.m2 / static_cast<double>(moment.count - 1) : 0.;
+    const double half = moment.count > 1 ? criticalValue(moment.count - 1) * std::sqrt(variance / static_cast<double>(moment.count)) : 0.;
+    return {statistic, key, moment.count, moment.mean, variance, moment.mean - half, moment.mean + half};
+}
+
+std::vector<EnsembleRow> ensemble(const std::function<Graph()>& generate, const std::uint64_t firstSeed, const int seedCount, const std::vector<std::string>& statistics, const std::string& fileName) {
+    if (seedCount <= 0) {
+        std::cerr << "Ensemble needs at least one seed, " << seedCount << " is invalid." << std::endl;
+        return std::vector<EnsembleRow>(0);
+    }
+    for (const std::string& statistic: statistics) {
+        if (std::ranges::find(knownStatistics, statistic) == knownStatistics.end()) {
+            std::cerr << "Unknown statistic " << statistic << ", only size, degree, cluster, distance, core and community are supported." << std::endl;
+            return std::vector<EnsembleRow>(0);
+        }
+    }
+    std::ofstream ofs;
+    if (!fileName.empty()) {
+        ofs.open(fileName);
+        if (!ofs.is_open()) {
+            std::cerr << "Cannot open " << fileName << " to write the ensemble result." << std::endl;
+            return std::vector<EnsembleRow>(0);
+        }
+        ofs << "statistic,key,count,mean,variance,lower,upper" << std::endl;
+    }
+    /* Seed i goes to stripe i % stripeCount and stripes are merged in order, so the sums do not depend on the thread
+     * count. Every worker owns whole stripes and seeds its own `gen`, only one graph per worker is alive and nested
+     * parallel calls run inline inside a worker. */
+    const int stripeCount = std::min(ensembleStripes, seedCount);
+    const int workers = std::min(threadCount(), stripeCount);
+    std::vector<Accumulator> partial(stripeCount);
+    const RandomStream saved = gen;
+    runWorkers(workers, [&](const int t) {
+        Worker worker;
+        for (int stripe = t; stripe < stripeCount; stripe += workers) {
+            for (int i = stripe; i < seedCount; i += stripeCount) {
+                gen.seed(firstSeed + i);
+                worker.graph = Graph(); // The last graph goes before the next one is built.
+                worker.graph = generate();
+                measure(worker, statistics, partial[stripe]);
+            }
+        }
+    });
+    gen = saved;
+    Accumulator total;
+    for (const Accumulator& accumulator: partial) {
+        for (const auto& [name, moment]: accumulator.scalar) {
+            total.scalar[name].merge(moment);
+        }
+        if (total.distribution.size() < accumulator.distribution.size()) {
+            total.distribution.resize(accumulator.distribution.size());
+        }
+        for (std::size_t k = 0; k < accumulator.distribution.size(); ++k) {
+            total.distribution[k].merge(accumulator.distribution[k]);
+        }
+        total.samples += accumulator.samples;
+    }
+    /* Every row is written the moment it is summarized. */
+    std::vector<EnsembleRow> rows;
+    const auto emit = [&](const EnsembleRow& row) {
+        if (ofs.is_open()) {
+            ofs << row.statistic << ',' << row.key << ',' << row.count << ',' << row.mean << ',' << row.variance << ',' << row.lower << ',' << row.upper << '\n';
+        }
+        rows.push_back(row);
+    };
+    for (const auto& [name, moment]: total.scalar) {
+        emit(summary(name, -1, moment));
+    }
+    for (std::size_t k = 0; k < total.distribution.size(); ++k) {
+        Moment moment = total.distribution[k];
+        moment.merge({total.samples - moment.count, 0., 0.}); // Graphs without degree k.
+        emit(summary("degreeDistribution", static_cast<int>(k), moment));
+    }
+    return rows;
+}
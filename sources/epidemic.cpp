@@ -0,0 +1,155 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <cmath>
+
+#include "../headers/epidemic.h"
+#include "../headers/parallel.h"
+#include "../headers/rng.h"
+
+namespace {
+    enum : unsigned char { susceptible = 0, infectious = 1, removed = 2, incoming = 3, ever = 0x80 };
+
+    /* Integer sums of one worker: curves by step, and the last state of finished realizations added from the step
+     * after they end, so the merge is exact whatever the thread count. */
+    struct Tally {
+        std::vector<long long> infected, recovered, tailInfected, tailRecovered;
+
+        void record(const std::size_t step, const long long infectedCount, const long long recoveredCount) {
+            if (infected.size() <= step) {
+                infected.resize(step + 1, 0);
+                recovered.resize(step + 1, 0);
+            }
+            infected[step] += infectedCount;
+            recovered[step] += recoveredCount;
+        }
+
+        void finish(const std::size_t step, const long long infectedCount, const long long recoveredCount) {
+            if (tailInfected.size() <= step + 1) {
+                tailInfected.resize(step + 2, 0);
+                tailRecovered.resize(step + 2, 0);
+            }
+            tailInfected[step + 1] += infectedCount;
+            tailRecovered[step + 1] += recoveredCount;
+        }
+    };
+}
+
+/* Threshold of a 32-bit draw, p = 1 always passes. */
+static std::uint64_t probabilityThreshold(const double probability) {
+    return static_cast<std::uint64_t>(std::ldexp(std::clamp(probability, 0., 1.), 32));
+}
+
+static int runRealization(const Graph& graph, const int model, const std::uint64_t infect, const std::uint64_t recover, const std::vector<int>& seeds,
+                          const int maxSteps, RandomStream& local, std::vector<unsigned char>& state, std::vector<int>& touched, Tally& tally) {
+    std::vector<int> frontier, next;
+    for (const int seed: seeds) {
+        if ((state[seed] & ~ever) == susceptible) {
+            state[seed] = infectious | ever;
+            touched.push_back(seed);
+            frontier.push_back(seed);
+        }
+    }
+    long long recoveredCount = 0;
+    int step = 0;
+    tally.record(0, static_cast<long long>(frontier.size()), 0);
+    /* Only the infectious frontier is visited, a step costs the degrees of the infected nodes. */
+    while (!frontier.empty() && step < maxSteps) {
+        next.clear();
+        for (const int node: frontier) {
+            for (const auto& [neighbor, weight]: graph.getNeighbors(node)) {
+                if ((state[neighbor] & ~ever) == susceptible && local() < infect) {
+                    if (!(state[neighbor] & ever)) {
+                        touched.push_back(neighbor);
+                    }
+                    state[neighbor] = incoming | ever;
+                    next.push_back(neighbor);
+                }
+            }
+        }
+        for (const int node: frontier) {
+            if (model == 2 || local() < recover) {
+                state[node] = (model == 1 ? susceptible : removed) | ever;
+                recoveredCount += model != 1;
+            } else {
+                next.push_back(node);
+            }
+        }
+        for (const int node: next) {
+            state[node] = infectious | ever;
+        }
+        frontier.swap(next);
+        tally.record(++step, static_cast<long long>(frontier.size()), recoveredCount);
+    }
+    tally.finish(step, static_cast<long long>(frontier.size()), recoveredCount);
+    const int outbreak = static_cast<int>(touched.size());
+    for (const int node: touched) {
+        state[node] = susceptible;
+    }
+    touched.clear();
+    return outbreak;
+}
+
+EpidemicResult simulate(const Graph& graph, const std::string& model, const double infectRate, const double recoverRate, const std::vector<int>& seeds, const int realizations, const int maxSteps) {
+    const int nodeCount = graph.getNodeCount();
+    const int kind = model == "sir" ? 0 : model == "sis" ? 1 : model == "ic" ? 2 : -1;
+    if (kind < 0) {
+        std::cerr << "Unknown spreading model " << model << ", only sir, sis and ic are supported." << std::endl;
+        return {};
+    }
+    if (infectRate < 0. || infectRate > 1. || recoverRate < 0. || recoverRate > 1.) {
+        std::cerr << "Infect rate and recover rate must be in [0, 1], " << infectRate << " and " << recoverRate << " are invalid." << std::endl;
+        return {};
+    }
+    if (!nodeCount || realizations <= 0 || maxSteps <= 0) {
+        std::cerr << "Simulation needs a non-empty graph, at least one realization and one step." << std::endl;
+        return {};
+    }
+    if (std::ranges::any_of(seeds, [nodeCount](const int seed) { return seed < 0 || seed >= nodeCount; })) {
+        std::cerr << "Seed node must be in [0, " << nodeCount << ")." << std::endl;
+        return {};
+    }
+    /* Realization r draws from its own stream, so every realization is the same on any thread. */
+    const std::uint64_t key = gen.next64(), infect = probabilityThreshold(infectRate), recover = probabilityThreshold(recoverRate);
+    const int workers = std::max(1, std::min(threadCount(), realizations));
+    std::vector<Tally> tally(workers);
+    EpidemicResult result;
+    result.outbreakSize.assign(realizations, 0);
+    parallelFor(0, realizations, [&](const int begin, const int end, const int t) {
+        std::vector<unsigned char> state(nodeCount, susceptible); // Reset through `touched` only, not by a full scan.
+        std::vector<int> touched, start(seeds);
+        for (int r = begin; r < end; ++r) {
+            RandomStream local(key, r);
+            if (seeds.empty()) {
+                start.assign(1, static_cast<int>(local.nextBelow(nodeCount)));
+            }
+            result.outbreakSize[r] = runRealization(graph, kind, infect, recover, start, maxSteps, local, state, touched, tally[t]);
+        }
+    });
+    std::size_t length = 0;
+    for (const Tally& part: tally) {
+        length = std::max(length, part.infected.size());
+    }
+    std::vector<long long> infected(length, 0), recovered(length, 0), tailInfected(length + 1, 0), tailRecovered(length + 1, 0);
+    for (const Tally& part: tally) {
+        for (std::size_t s = 0; s < part.infected.size(); ++s) {
+            infected[s] += part.infected[s];
+            recovered[s] += part.recovered[s];
+        }
+        for (std::size_t s = 0; s < part.tailInfected.size(); ++s) {
+            tailInfected[s] += part.tailInfected[s];
+            tailRecovered[s] += part.tailRecovered[s];
+        }
+    }
+    result.infected.resize(length);
+    result.recovered.resize(length);
+    long long carryInfected = 0, carryRecovered = 0;
+    for (std::size_t s = 0; s < length; ++s) {
+        carryInfected += tailInfected[s];
+        carryRecovered += tailRecovered[s];
+        result.infected[s] = static_cast<double>(infected[s] + carryInfected) / realizations;
+        result.recovered[s] = static_cast<double>(recovered[s] + carryRecovered) / realizations;
+    }
+    return result;
+}
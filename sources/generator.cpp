@@ -2,183 +2,431 @@
 // Created by Ivor on 2025/12/24.
 //
 
+#include <climits>
+#include <cmath>
+#include <unordered_set>
+
 #include "../headers/generator.h"
+#include "../headers/parallel.h"
 
-Graph fullConnect(const int nodeCount) {
-    auto ret = Graph(nodeCount);
-    for (int i = 0; i < nodeCount; ++i) {
-        for (int j = 0; j < i; ++j) {
-            ret.addEdge({i, j, 1.});
+/* Sorts a generated row and merges repeated neighbors by adding their weights, as `addEdge` would. */
+static void mergeRow(std::vector<std::pair<int, double>>& row) {
+    std::ranges::sort(row);
+    std::size_t kept = 0;
+    for (std::size_t k = 0; k < row.size(); ++k) {
+        if (kept && row[kept - 1].first == row[k].first) {
+            row[kept - 1].second += row[k].second;
+        } else {
+            row[kept++] = row[k];
         }
     }
-    return ret;
+    row.resize(kept);
 }
 
-Graph lattice(const int size, const int dim) {
-    int nodeCount = 1;
-    for (int i = 0; i < dim; ++i) {
-        nodeCount *= size;
-    }
-    auto ret = Graph(nodeCount, false);
-    for (int i = 0; i < nodeCount; ++i) {
-        int tier = 1;
-        for (int j = 0; j < dim; ++j) {
-            int neighborIndex = i + tier;
-            if (((i / tier) % size) == size - 1) {
-                neighborIndex = i - (size-1) * tier;
-            }
-            ret.addEdge({i, neighborIndex, 1.});
-            tier *= size;
+/* Closed-form neighbor lists of the regular structures, shared by the in-memory and the streaming generators. */
+static void fullConnectRow(const int nodeCount, const int i, std::vector<std::pair<int, double>>& row) {
+    row.reserve(nodeCount - 1);
+    for (int j = 0; j < nodeCount; ++j) {
+        if (j != i) {
+            row.emplace_back(j, 1.);
         }
     }
-    return ret;
 }
 
-Graph ring(const int nodeCount, const int degree) {
+static void latticeRow(const int size, const int dim, const int i, std::vector<std::pair<int, double>>& row) {
+    /* Node i links to i +/- tier in every dimension, with period boundary. */
+    row.reserve(2 * dim);
+    int tier = 1;
+    for (int j = 0; j < dim; ++j) {
+        const int coordinate = (i / tier) % size;
+        row.emplace_back(coordinate == size - 1 ? i - (size-1) * tier : i + tier, 1.);
+        row.emplace_back(coordinate == 0 ? i + (size-1) * tier : i - tier, 1.);
+        tier *= size;
+    }
+    mergeRow(row);
+}
+
+static void ringRow(const int nodeCount, const int degree, const int i, std::vector<std::pair<int, double>>& row) {
+    row.reserve(degree + 1);
+    for (int j = 1; j <= (degree >> 1); ++j) {
+        row.emplace_back((i+j) % nodeCount, 1.);
+        row.emplace_back((i-j+nodeCount) % nodeCount, 1.);
+    }
+    mergeRow(row);
+}
+
+static void oddRegularRow(const int nodeCount, const int degree, const int i, std::vector<std::pair<int, double>>& row) {
+    /* A ring with degree-1 neighbors, plus a chord from i to i + nodeCount/2 for the first half. */
+    const int half = nodeCount >> 1;
+    ringRow(nodeCount, degree - 1, i, row);
+    if (i < half) {
+        row.emplace_back(i + half, 1.);
+    } else if (i - half < half) {
+        row.emplace_back(i - half, 1.);
+    }
+    mergeRow(row);
+}
+
+static bool checkRing(const int nodeCount, const int degree) {
     if (degree < 0) {
         std::cerr << "Nodes cannot have NEGATIVE neighbors: " << degree << "." << std::endl;
-        return Graph();
+        return false;
     }
     if (degree & 1) {
         std::cerr << "Nodes on ring structure MUST have even neighbor(s), " << degree << " is invalid." << std::endl;
-        return Graph();
+        return false;
     }
     if (degree >= nodeCount) {
         std::cerr << "Cannot generate a graph with " << nodeCount << " node(s), and each node have " << degree << " neighbor(s)." << std::endl;
-        return Graph();
+        return false;
     }
     if (!degree) {
         std::cout << "Warning! Nodes will have no neighbor." << std::endl;
     }
-    auto ret = Graph(nodeCount, false);
-    for (int i = 0; i < nodeCount; ++i) {
-        for (int j = 0; j < (degree >> 1); ++j) {
-            ret.addEdge({i, (i+1+j) % nodeCount, 1.});
-        }
-    }
-    return ret;
+    return true;
 }
 
-Graph oddRegular(const int nodeCount, const int degree) {
+static bool checkOddRegular(const int nodeCount, const int degree) {
     if (degree < 3) {
         std::cerr << "Too few neighbor(s): " << degree << "." << std::endl;
-        return Graph();
+        return false;
     }
     if (!(degree & 1)) {
         std::cerr << "Here we need a odd number, " << degree << " is invalid. You may try `ring` method to generate." << std::endl;
-        return Graph();
+        return false;
     }
     if (degree >= nodeCount) {
         std::cerr << "Cannot generate a graph with " << nodeCount << " node(s), and each node have " << degree << " neighbor(s)." << std::endl;
-        return Graph();
+        return false;
     }
     if (nodeCount & 1) {
         std::cerr << "Odd regular graph must have even nodes, " << nodeCount << " is invalid." << std::endl;
     }
-    Graph ret = ring(nodeCount, degree-1);
-    for (int i = 0; i < (nodeCount >> 1); ++i) {
-        ret.addEdge({i, i + (nodeCount >> 1), 1.});
+    return true;
+}
+
+static int latticeNodeCount(const int size, const int dim) {
+    int nodeCount = 1;
+    for (int i = 0; i < dim; ++i) {
+        nodeCount *= size;
+    }
+    return nodeCount;
+}
+
+/* Streams a structure given by rows: rows are built on all threads in batches of about `streamBatch` entries, and
+ * every row hands over its edges towards larger ids (and half of a self-loop weight, which is stored twice). */
+static constexpr long long streamBatch = 1LL << 22;
+
+static long long streamRows(EdgeFileWriter& file, const int nodeCount, const int rowSize, const std::function<void(int, std::vector<std::pair<int, double>>&)>& rowBuilder) {
+    file.setNodeCount(nodeCount);
+    const int batchRows = static_cast<int>(std::clamp(streamBatch / std::max(rowSize, 1), 1LL, static_cast<long long>(INT_MAX)));
+    std::vector<std::vector<std::tuple<int, int, double>>> partial(threadCount());
+    for (int batch = 0; batch < nodeCount; batch += std::min(batchRows, nodeCount - batch)) {
+        const int batchEnd = batch + std::min(batchRows, nodeCount - batch);
+        const int workers = std::min(threadCount(), batchEnd - batch);
+        parallelFor(batch, batchEnd, [&](const int begin, const int end, const int t) {
+            std::vector<std::pair<int, double>> row;
+            for (int i = begin; i < end; ++i) {
+                row.clear();
+                rowBuilder(i, row);
+                for (const auto& [neighbor, weight]: row) {
+                    if (neighbor > i) {
+                        partial[t].emplace_back(i, neighbor, weight);
+                    } else if (neighbor == i) {
+                        partial[t].emplace_back(i, i, weight / 2.);
+                    }
+                }
+            }
+        });
+        for (int t = 0; t < workers; ++t) {
+            file.add(partial[t]); // Worker ranges are in row order, so is the stream.
+            partial[t].clear();
+        }
+    }
+    return file.finish();
+}
+
+Graph fullConnect(const int nodeCount) {
+    return {nodeCount, [nodeCount](const int i, std::vector<std::pair<int, double>>& row) {
+        fullConnectRow(nodeCount, i, row);
+    }};
+}
+
+long long fullConnect(EdgeFileWriter& file, const int nodeCount) {
+    return streamRows(file, nodeCount, nodeCount, [nodeCount](const int i, std::vector<std::pair<int, double>>& row) {
+        fullConnectRow(nodeCount, i, row);
+    });
+}
+
+Graph lattice(const int size, const int dim) {
+    return {latticeNodeCount(size, dim), [size, dim](const int i, std::vector<std::pair<int, double>>& row) {
+        latticeRow(size, dim, i, row);
+    }, false};
+}
+
+long long lattice(EdgeFileWriter& file, const int size, const int dim) {
+    return streamRows(file, latticeNodeCount(size, dim), 2 * dim, [size, dim](const int i, std::vector<std::pair<int, double>>& row) {
+        latticeRow(size, dim, i, row);
+    });
+}
+
+Graph ring(const int nodeCount, const int degree) {
+    if (!checkRing(nodeCount, degree)) {
+        return Graph();
+    }
+    return {nodeCount, [nodeCount, degree](const int i, std::vector<std::pair<int, double>>& row) {
+        ringRow(nodeCount, degree, i, row);
+    }, false};
+}
+
+long long ring(EdgeFileWriter& file, const int nodeCount, const int degree) {
+    if (!checkRing(nodeCount, degree)) {
+        return -1;
+    }
+    return streamRows(file, nodeCount, degree, [nodeCount, degree](const int i, std::vector<std::pair<int, double>>& row) {
+        ringRow(nodeCount, degree, i, row);
+    });
+}
+
+Graph oddRegular(const int nodeCount, const int degree) {
+    if (!checkOddRegular(nodeCount, degree)) {
+        return Graph();
+    }
+    return {nodeCount, [nodeCount, degree](const int i, std::vector<std::pair<int, double>>& row) {
+        oddRegularRow(nodeCount, degree, i, row);
+    }, false};
+}
+
+long long oddRegular(EdgeFileWriter& file, const int nodeCount, const int degree) {
+    if (!checkOddRegular(nodeCount, degree)) {
+        return -1;
     }
-    return ret;
+    return streamRows(file, nodeCount, degree, [nodeCount, degree](const int i, std::vector<std::pair<int, double>>& row) {
+        oddRegularRow(nodeCount, degree, i, row);
+    });
 }
 
-void reconnect(Graph& graph, const double rate, const int mode) {
+/* Rewires every edge with probability `rate` on a flat edge array, existence is checked in a hash set and the graph
+ * is rebuilt once at the end. Without `keepDegree` (Watts-Strogatz) the far end of a chosen edge moves to a random
+ * node that is not linked yet. With `keepDegree` (regular Erdös-Rényi) a chosen edge swaps ends with a random other
+ * edge instead, so every degree is kept; a swap that would make a self-loop or a repeated edge is retried a few
+ * times and then given up. */
+static void reconnect(Graph& graph, const double rate, const bool keepDegree) {
     const int nodeCount = graph.getNodeCount();
-    std::uniform_real_distribution<double> dist(0., 1.);
-    std::uniform_int_distribution<int> range(0, nodeCount - 1);
+    const bool directed = graph.isDirected();
+    /* Undirected edges are taken once from their larger end, in the same node order as the old per-node loop. */
+    std::vector<std::size_t> first(nodeCount + 1, 0);
     for (int i = 0; i < nodeCount; ++i) {
-        if (!mode) {
-            for (int j = 0; j < i; ++j) {
-                if (dist(gen) < rate) {
-                    graph.addEdge({i, j, 1.});
+        std::size_t count = 0;
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            count += directed || neighbor <= i;
+        }
+        first[i + 1] = first[i] + count;
+    }
+    std::vector<std::tuple<int, int, double>> edges(first[nodeCount]);
+    std::vector<int> degree(nodeCount, 0); // Links to other nodes, self-loops aside.
+    parallelFor(0, nodeCount, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            std::size_t k = first[i];
+            for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+                if (directed || neighbor <= i) {
+                    edges[k++] = {i, neighbor, !directed && neighbor == i ? weight / 2. : weight}; // Undirected self-loop weight is stored twice.
                 }
+                degree[i] += neighbor != i;
             }
-        } else if (!~mode) {
-            for (std::vector<std::pair<int, double>> neighbors = graph.getNeighbors(i); std::pair<int, double> neighbor: neighbors) {
-                if (i < neighbor.first) {
-                    break;
-                }
-                if (dist(gen) < rate) {
-                    if (!std::ranges::binary_search(graph.getNeighbors(i), std::make_pair(neighbor.first, 1.),
-                                                    [](const std::pair<int, double>& left, const std::pair<int, double>& right) {
-                                                        return left.first < right.first;
-                                                    })) {
-                        continue;
-                    }
-                    graph.removeEdge({i, neighbor.first});
-                    int newNeighbor = range(gen);
-                    while (newNeighbor == i || std::ranges::binary_search(graph.getNeighbors(i), std::make_pair(newNeighbor, 1.),
-                                                                          [](const std::pair<int, double>& left, const std::pair<int, double>& right) {
-                                                                              return left.first < right.first;
-                                                                          })) {
-                        newNeighbor = range(gen);
-                    }
-                    graph.addEdge({i, newNeighbor, 1.});
-                    std::pair<int, int> nextEdge(newNeighbor, -1);
-                    while (true) {
-                        std::uniform_int_distribution<int> local(0, static_cast<int>(graph.getNeighbors(nextEdge.first).size()) - 1);
-                        int iter = graph.getNeighbors(nextEdge.first)[local(gen)].first;
-                        graph.removeEdge({nextEdge.first, iter});
-                        nextEdge.first = iter;
-                        while (nextEdge.first == nextEdge.second || !~nextEdge.second ||
-                               std::ranges::binary_search(graph.getNeighbors(nextEdge.first), std::make_pair(nextEdge.second, 1.),
-                                                          [](const std::pair<int, double>& left, const std::pair<int, double>& right) {
-                                                              return left.first < right.first;
-                                                          })) {
-                            nextEdge.second = range(gen);
-                        }
-                        graph.addEdge({nextEdge.first, nextEdge.second, 1.});
-                        if (nextEdge.second == neighbor.first) {
-                            break;
-                        }
-                        nextEdge.first = nextEdge.second;
-                        nextEdge.second = -1;
-                    }
-                }
+        }
+    });
+    const auto pairKey = [nodeCount, directed](int left, int right) {
+        if (!directed && left < right) {
+            std::swap(left, right);
+        }
+        return static_cast<std::uint64_t>(left) * nodeCount + right;
+    };
+    std::unordered_set<std::uint64_t> present;
+    present.reserve(edges.size() * 2);
+    for (const auto& [left, right, weight]: edges) {
+        present.insert(pairKey(left, right));
+    }
+    /* All coin flips in one parallel pass, node i flips on its own stream. */
+    const std::uint64_t key = gen.next64();
+    std::vector<char> chosen(edges.size(), 0);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            RandomStream local(key, i);
+            for (std::size_t e = first[i]; e < first[i + 1]; ++e) {
+                chosen[e] = local.nextDouble() < rate;
             }
-        } else {
-            for (std::vector<std::pair<int, double>> neighbors = graph.getNeighbors(i); std::pair<int, double> neighbor: neighbors) {
-                if (i < neighbor.first) {
-                    break;
+        }
+    });
+    RandomStream pick(key, nodeCount); // Stream ids below `nodeCount` are taken by the coin flips.
+    const std::size_t edgeTotal = edges.size();
+    for (std::size_t e = 0; e < edgeTotal; ++e) {
+        if (!chosen[e]) {
+            continue;
+        }
+        auto& [i, j, weight] = edges[e];
+        if (keepDegree) {
+            for (int attempt = 0; attempt < 16 && i != j && edgeTotal > 1; ++attempt) {
+                const std::size_t f = pick.nextBelow(edgeTotal);
+                auto [u, v, fWeight] = edges[f];
+                if (!directed && (pick() & 1)) {
+                    std::swap(u, v);
                 }
-                if (dist(gen) < rate) {
-                    graph.removeEdge({i, neighbor.first});
-                    int newNeighbor = range(gen);
-                    while (newNeighbor == i || std::ranges::binary_search(graph.getNeighbors(i), std::make_pair(newNeighbor, 1.),
-                                                                          [](const std::pair<int, double>& left, const std::pair<int, double>& right) {
-                                                                              return left.first < right.first;
-                                                                          })) {
-                        newNeighbor = range(gen);
-                    }
-                    graph.addEdge({i, newNeighbor, 1.});
+                if (f == e || i == v || u == j || present.contains(pairKey(i, v)) || present.contains(pairKey(u, j))) {
+                    continue;
                 }
+                present.erase(pairKey(i, j));
+                present.erase(pairKey(std::get<0>(edges[f]), std::get<1>(edges[f])));
+                present.insert(pairKey(i, v));
+                present.insert(pairKey(u, j));
+                edges[f] = {u, j, fWeight};
+                j = v;
+                break;
             }
+            continue;
         }
+        if (j != i) {
+            present.erase(pairKey(i, j));
+            degree[i]--;
+            if (!directed) {
+                degree[j]--;
+            }
+        }
+        if (degree[i] >= nodeCount - 1) {
+            continue; // Only a self-loop was chosen and `i` already links to everyone, keep it.
+        }
+        int newNeighbor = static_cast<int>(pick.nextBelow(nodeCount));
+        while (newNeighbor == i || present.contains(pairKey(i, newNeighbor))) {
+            newNeighbor = static_cast<int>(pick.nextBelow(nodeCount));
+        }
+        present.insert(pairKey(i, newNeighbor));
+        degree[i]++;
+        if (!directed) {
+            degree[newNeighbor]++;
+        }
+        j = newNeighbor;
     }
+    graph = Graph(nodeCount, edges, directed);
+}
+
+/* G(n, p) on the pairs (v, w), w < v, of rows [rowBegin, rowEnd), in row-major order. The gap between two hits is
+ * geometric (Batagelj-Brandes), so only the hits and the row ends are visited. */
+static void geometricPairs(const int rowBegin, const int rowEnd, const double rate, RandomStream local, std::vector<std::tuple<int, int, double>>& edges) {
+    const double logMiss = std::log1p(-std::min(rate, 1.)); // -inf when rate is 1, every gap is then zero.
+    const double pairLimit = static_cast<double>(rowEnd) * rowEnd;
+    edges.reserve(static_cast<std::size_t>(std::min(rate, 1.) * ((static_cast<double>(rowEnd) * (rowEnd - 1) - static_cast<double>(rowBegin) * (rowBegin - 1)) / 2.) * 1.05) + 16);
+    long long v = rowBegin, w = -1;
+    while (v < rowEnd) {
+        const double skip = std::floor(std::log1p(-local.nextDouble()) / logMiss);
+        if (skip >= pairLimit) {
+            break; // Beyond the last pair of this chunk.
+        }
+        w += 1 + static_cast<long long>(skip);
+        while (v < rowEnd && w >= v) {
+            w -= v;
+            v++;
+        }
+        if (v < rowEnd) {
+            edges.emplace_back(static_cast<int>(v), static_cast<int>(w), 1.);
+        }
+    }
+}
+
+/* Rows are cut into chunks of about `chunkPairs` pairs, every chunk has its own stream, so the graph is the same for
+ * any thread count, in memory or streamed. */
+static std::vector<int> pairChunks(const int nodeCount) {
+    constexpr long long chunkPairs = 1LL << 22;
+    std::vector<int> chunkRow(1, 1); // Row 0 has no pair.
+    while (chunkRow.back() < nodeCount) {
+        int row = chunkRow.back();
+        for (long long pairs = 0; row < nodeCount && pairs < chunkPairs; ++row) {
+            pairs += row;
+        }
+        chunkRow.push_back(row);
+    }
+    return chunkRow;
 }
 
 Graph erRandom(const int nodeCount, const int averageDegree, const double connectRate, const bool isRegular) {
     if (isRegular) {
         if (averageDegree & 1) {
             Graph ret = oddRegular(nodeCount, averageDegree);
-            reconnect(ret, connectRate, -1);
+            reconnect(ret, connectRate, true);
             return ret;
         }
         Graph ret = ring(nodeCount, averageDegree);
-        reconnect(ret, connectRate, -1);
+        reconnect(ret, connectRate, true);
         return ret;
     }
     std::cout << "Arg `averageDegree` is not effective for irregular Erdös-Rényi random network." << std::endl;
-    auto ret = Graph(nodeCount);
-    reconnect(ret, connectRate, 0);
-    return ret;
+    return erRandom(nodeCount, connectRate);
+}
+
+Graph erRandom(const int nodeCount, const double connectRate) {
+    if (nodeCount <= 0 || connectRate <= 0.) {
+        return Graph(std::max(nodeCount, 0));
+    }
+    const std::vector<int> chunkRow = pairChunks(nodeCount);
+    const int chunkCount = static_cast<int>(chunkRow.size()) - 1;
+    const std::uint64_t key = gen.next64();
+    std::vector<std::vector<std::tuple<int, int, double>>> chunkEdges(chunkCount);
+    parallelFor(0, chunkCount, [&](const int begin, const int end, int) {
+        for (int c = begin; c < end; ++c) {
+            geometricPairs(chunkRow[c], chunkRow[c + 1], connectRate, RandomStream(key, c), chunkEdges[c]);
+        }
+    });
+    std::size_t edgeCount = 0;
+    for (const auto& edges: chunkEdges) {
+        edgeCount += edges.size();
+    }
+    std::vector<std::tuple<int, int, double>> edges;
+    edges.reserve(edgeCount);
+    for (auto& chunk: chunkEdges) {
+        edges.insert(edges.end(), chunk.begin(), chunk.end());
+        std::vector<std::tuple<int, int, double>>().swap(chunk);
+    }
+    return {nodeCount, edges};
+}
+
+long long erRandom(EdgeFileWriter& file, const int nodeCount, const double connectRate) {
+    if (nodeCount < 0) {
+        std::cerr << "Cannot generate a graph with " << nodeCount << " node(s)." << std::endl;
+        return -1;
+    }
+    file.setNodeCount(nodeCount);
+    if (connectRate <= 0.) {
+        return file.finish();
+    }
+    const std::vector<int> chunkRow = pairChunks(nodeCount);
+    const int chunkCount = static_cast<int>(chunkRow.size()) - 1;
+    const std::uint64_t key = gen.next64();
+    /* Chunks run in batches that hold about `streamBatch` expected edges. */
+    const int batchChunks = static_cast<int>(std::clamp(static_cast<long long>(streamBatch / ((1LL << 22) * std::min(connectRate, 1.) + 1.)), 1LL, static_cast<long long>(threadCount()) * 4));
+    std::vector<std::vector<std::tuple<int, int, double>>> chunkEdges(batchChunks);
+    for (int batch = 0; batch < chunkCount; batch += batchChunks) {
+        const int batchEnd = std::min(chunkCount, batch + batchChunks);
+        parallelFor(batch, batchEnd, [&](const int begin, const int end, int) {
+            for (int c = begin; c < end; ++c) {
+                geometricPairs(chunkRow[c], chunkRow[c + 1], connectRate, RandomStream(key, c), chunkEdges[c - batch]);
+            }
+        });
+        for (int c = batch; c < batchEnd; ++c) {
+            file.add(chunkEdges[c - batch]);
+            std::vector<std::tuple<int, int, double>>().swap(chunkEdges[c - batch]);
+        }
+    }
+    return file.finish();
 }
 
 void wsSmallWorld(Graph& graph, const double reconnectRate) {
-    reconnect(graph, reconnectRate, 1);
+    reconnect(graph, reconnectRate, false);
 }
 
 Graph baScaleFree(const int nodeCount, const int averageDegree) {
+    if (averageDegree < 0) {
+        std::cerr << "Nodes cannot have NEGATIVE neighbors: " << averageDegree << "." << std::endl;
+        return Graph();
+    }
     if (nodeCount + 1 < averageDegree) {
         std::cerr << "Too few node(s) " << nodeCount << " for " << averageDegree << " average degree." << std::endl;
         return Graph();
@@ -187,36 +435,284 @@ Graph baScaleFree(const int nodeCount, const int averageDegree) {
         std::cerr << "Neither average degree " << averageDegree << " nor node count " << nodeCount <<" can be odd." << std::endl;
         return Graph();
     }
-    Graph ret = fullConnect(averageDegree + 1);
-    std::vector<int> degreeList(averageDegree + 1, averageDegree);
-    for (int i = averageDegree + 1; i < nodeCount; ++i) {
-        ret.addNode();
+    /* Repeated endpoints (Batagelj-Brandes): a node is drawn with weight `averageDegree` plus the links it has
+     * received. The constant part is implicit (index / averageDegree), only received endpoints are stored. */
+    const int seedCount = std::min(nodeCount, averageDegree + 1);
+    std::vector<std::tuple<int, int, double>> edges;
+    edges.reserve(static_cast<std::size_t>(seedCount) * averageDegree / 2 + static_cast<std::size_t>(nodeCount - seedCount) * ((averageDegree >> 1) + 1));
+    for (int i = 0; i < seedCount; ++i) {
+        for (int j = 0; j < i; ++j) {
+            edges.emplace_back(i, j, 1.);
+        }
+    }
+    std::vector<int> received;
+    received.reserve(edges.capacity());
+    std::vector<int> selected;
+    RandomStream local(gen.next64()); // Attachment depends on every earlier node, so it is one stream.
+    for (int i = seedCount; i < nodeCount; ++i) {
         const int selectedCount = (averageDegree >> 1) + ((averageDegree & 1) ? (i & 1) : 0);
-        std::vector<int> selected(0);
-        std::vector<int> weights(degreeList.size());
-        std::ranges::copy(degreeList, weights.begin());
-        int totalWeight = std::accumulate(weights.begin(), weights.end(), 0);
-        for (int j = 0; j < selectedCount; ++j) {
-            std::uniform_int_distribution<int> sample(0, totalWeight - 1);
-            int locate = sample(gen);
-            for (int k = 0; k < i; ++k) {
-                if (!weights[k]) {
-                    continue;
-                }
-                locate -= weights[k];
-                if (locate <= 0) {
-                    selected.push_back(k);
-                    totalWeight -= weights[k];
-                    weights[k] = 0;
-                    break;
+        if (!selectedCount) {
+            continue;
+        }
+        const long long base = static_cast<long long>(i) * averageDegree;
+        selected.clear();
+        while (static_cast<int>(selected.size()) < selectedCount) {
+            const long long locate = static_cast<long long>(local.nextBelow(base + received.size()));
+            const int obj = locate < base ? static_cast<int>(locate / averageDegree) : received[locate - base];
+            if (std::ranges::find(selected, obj) == selected.end()) {
+                selected.push_back(obj); // Rejecting repeats equals drawing without replacement.
+            }
+        }
+        for (const int obj: selected) {
+            edges.emplace_back(i, obj, 1.);
+            received.push_back(obj);
+        }
+    }
+    return {nodeCount, edges};
+}
+
+/* Draws `count` R-MAT edges into `out` and returns how many are kept. Every level of the 2x2 initiator takes 16
+ * random bits, compared with integer thresholds without branches: [0, ta) none, [ta, tb) column, [tb, tc) row and
+ * [tc, 1) both. */
+static long long rmatEdges(RandomStream local, const int scale, const std::uint32_t ta, const std::uint32_t tb, const std::uint32_t tc, const int* label, std::tuple<int, int, double>* out, const long long count) {
+    long long kept = 0;
+    for (long long e = 0; e < count; ++e) {
+        std::uint32_t u = 0, v = 0;
+        for (int level = 0; level < scale; level += 2) {
+            const std::uint32_t word = local();
+            for (int half = 0; half < 2 && level + half < scale; ++half) {
+                const std::uint32_t r = word >> (half << 4) & 0xFFFF;
+                u = u << 1 | (r >= tb);
+                v = v << 1 | ((r >= ta && r < tb) || r >= tc);
+            }
+        }
+        if (u != v) {
+            out[kept++] = {label[u], label[v], 1.}; // Self-loops are dropped.
+        }
+    }
+    return kept;
+}
+
+static bool checkRmat(const int scale, const int edgeFactor, const double a, const double b, const double c) {
+    if (scale < 1 || scale > 30) {
+        std::cerr << "R-MAT scale must be in [1, 30], " << scale << " is invalid." << std::endl;
+        return false;
+    }
+    if (edgeFactor < 1) {
+        std::cerr << "Cannot generate " << edgeFactor << " edges per node for 2^" << scale << " node(s)." << std::endl;
+        return false;
+    }
+    if (a < 0. || b < 0. || c < 0. || a + b + c > 1.) {
+        std::cerr << "R-MAT probabilities " << a << ", " << b << ", " << c << " must be non-negative with a sum no more than 1." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/* Labels are shuffled (Graph500 style), otherwise the hubs all sit at small ids. Stream 0 is used here, chunk c
+ * draws its edges from stream c + 1. */
+static std::vector<int> rmatLabel(const int nodeCount, const std::uint64_t key) {
+    std::vector<int> label(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) {
+        label[i] = i;
+    }
+    RandomStream shuffle(key, 0);
+    for (int i = nodeCount - 1; i > 0; --i) {
+        std::swap(label[i], label[shuffle.nextBelow(i + 1)]);
+    }
+    return label;
+}
+
+static std::uint32_t rmatThreshold(const double p) {
+    return static_cast<std::uint32_t>(std::min(p, 1.) * 65536.);
+}
+
+Graph rmat(const int scale, const int edgeFactor, const double a, const double b, const double c) {
+    if (!checkRmat(scale, edgeFactor, a, b, c)) {
+        return Graph();
+    }
+    if ((static_cast<long long>(edgeFactor) << scale) > INT_MAX) {
+        std::cerr << "Cannot generate " << edgeFactor << " edges per node for 2^" << scale << " node(s) in memory, stream them into a file instead." << std::endl;
+        return Graph();
+    }
+    const int nodeCount = 1 << scale;
+    const long long edgeTotal = static_cast<long long>(edgeFactor) << scale;
+    const std::uint32_t ta = rmatThreshold(a), tb = rmatThreshold(a + b), tc = rmatThreshold(a + b + c);
+    const std::uint64_t key = gen.next64();
+    const std::vector<int> label = rmatLabel(nodeCount, key);
+    constexpr long long chunkEdges = 1LL << 20;
+    const int chunkCount = static_cast<int>((edgeTotal + chunkEdges - 1) / chunkEdges);
+    std::vector<std::tuple<int, int, double>> edges(edgeTotal);
+    std::vector<long long> chunkKept(chunkCount, 0);
+    parallelFor(0, chunkCount, [&](const int begin, const int end, int) {
+        for (int chunk = begin; chunk < end; ++chunk) {
+            const long long first = chunk * chunkEdges;
+            chunkKept[chunk] = rmatEdges(RandomStream(key, chunk + 1), scale, ta, tb, tc, label.data(), edges.data() + first, std::min(edgeTotal, first + chunkEdges) - first);
+        }
+    });
+    /* Chunks are packed in order, repeated edges merge into one heavier edge. */
+    std::size_t kept = 0;
+    for (int chunk = 0; chunk < chunkCount; ++chunk) {
+        const auto first = edges.begin() + chunk * chunkEdges;
+        kept = std::move(first, first + chunkKept[chunk], edges.begin() + static_cast<long long>(kept)) - edges.begin();
+    }
+    edges.resize(kept);
+    return {nodeCount, edges};
+}
+
+long long rmat(EdgeFileWriter& file, const int scale, const int edgeFactor, const double a, const double b, const double c) {
+    if (!checkRmat(scale, edgeFactor, a, b, c)) {
+        return -1;
+    }
+    const int nodeCount = 1 << scale;
+    const long long edgeTotal = static_cast<long long>(edgeFactor) << scale;
+    const std::uint32_t ta = rmatThreshold(a), tb = rmatThreshold(a + b), tc = rmatThreshold(a + b + c);
+    const std::uint64_t key = gen.next64();
+    const std::vector<int> label = rmatLabel(nodeCount, key);
+    file.setNodeCount(nodeCount);
+    /* Same chunks and streams as in memory, a batch of chunks at a time. */
+    constexpr long long chunkEdges = 1LL << 20;
+    const long long chunkCount = (edgeTotal + chunkEdges - 1) / chunkEdges;
+    const int batchChunks = static_cast<int>(std::max<long long>(threadCount(), streamBatch / chunkEdges));
+    std::vector<std::vector<std::tuple<int, int, double>>> chunkBuffer(batchChunks, std::vector<std::tuple<int, int, double>>(chunkEdges));
+    for (long long batch = 0; batch < chunkCount; batch += batchChunks) {
+        const int count = static_cast<int>(std::min<long long>(batchChunks, chunkCount - batch));
+        parallelFor(0, count, [&](const int begin, const int end, int) {
+            for (int k = begin; k < end; ++k) {
+                const long long first = (batch + k) * chunkEdges;
+                chunkBuffer[k].resize(chunkEdges);
+                chunkBuffer[k].resize(rmatEdges(RandomStream(key, batch + k + 1), scale, ta, tb, tc, label.data(), chunkBuffer[k].data(), std::min(edgeTotal, first + chunkEdges) - first));
+            }
+        });
+        for (int k = 0; k < count; ++k) {
+            file.add(chunkBuffer[k]);
+        }
+    }
+    return file.finish();
+}
+
+Graph configurationModel(const std::vector<int>& degrees) {
+    const int nodeCount = static_cast<int>(degrees.size());
+    std::vector<long long> stubOffset(nodeCount + 1, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        if (degrees[i] < 0) {
+            std::cerr << "Nodes cannot have NEGATIVE neighbors: " << degrees[i] << " at node " << i << "." << std::endl;
+            return Graph();
+        }
+        stubOffset[i + 1] = stubOffset[i] + degrees[i];
+    }
+    const long long stubCount = stubOffset[nodeCount];
+    if (stubCount & 1) {
+        std::cerr << "Degree sequence must have an even sum, " << stubCount << " is invalid." << std::endl;
+        return Graph();
+    }
+    if (stubCount / 2 > INT_MAX) {
+        std::cerr << "Too many edges for one graph: " << stubCount / 2 << "." << std::endl;
+        return Graph();
+    }
+    /* Stubs are shuffled by random scattering into buckets and then shuffling every bucket (Rao-Sandelius). Both
+     * steps use fixed chunks with their own streams, so the pairing does not depend on the thread count. Buckets are
+     * capped at 4096 (a constant, not the thread count, to keep the pairing fixed), so the chunk x bucket table
+     * grows linearly with the stubs: 32MB of int offsets at 2^31 stubs. */
+    constexpr long long chunkStubs = 1LL << 20;
+    constexpr int maxBuckets = 1 << 12;
+    const int chunkCount = static_cast<int>((stubCount + chunkStubs - 1) / chunkStubs);
+    const int bucketCount = static_cast<int>(std::clamp(stubCount >> 16, 1LL, static_cast<long long>(maxBuckets)));
+    const std::uint64_t key = gen.next64();
+    std::vector<std::uint16_t> bucket(stubCount);
+    std::vector<std::vector<int>> bucketFill(chunkCount, std::vector<int>(bucketCount, 0)); // Counts, then offsets inside the bucket.
+    parallelFor(0, chunkCount, [&](const int begin, const int end, int) {
+        for (int chunk = begin; chunk < end; ++chunk) {
+            RandomStream local(key, chunk);
+            const long long last = std::min(stubCount, (chunk + 1) * chunkStubs);
+            for (long long s = chunk * chunkStubs; s < last; ++s) {
+                bucket[s] = static_cast<std::uint16_t>(local.nextBelow(bucketCount));
+                bucketFill[chunk][bucket[s]]++;
+            }
+        }
+    });
+    std::vector<long long> bucketOffset(bucketCount + 1, 0);
+    long long position = 0;
+    for (int b = 0; b < bucketCount; ++b) {
+        bucketOffset[b] = position;
+        int inside = 0; // At most 2^32 stubs over 4096 buckets, a bucket stays far below INT_MAX.
+        for (int chunk = 0; chunk < chunkCount; ++chunk) {
+            const int count = bucketFill[chunk][b];
+            bucketFill[chunk][b] = inside; // From now on, where this chunk writes into bucket b.
+            inside += count;
+        }
+        position += inside;
+    }
+    bucketOffset[bucketCount] = position;
+    std::vector<int> stub(stubCount);
+    parallelFor(0, chunkCount, [&](const int begin, const int end, int) {
+        for (int chunk = begin; chunk < end; ++chunk) {
+            const long long first = chunk * chunkStubs, last = std::min(stubCount, first + chunkStubs);
+            int node = static_cast<int>(std::ranges::upper_bound(stubOffset, first) - stubOffset.begin()) - 1;
+            for (long long s = first; s < last; ++s) {
+                while (stubOffset[node + 1] <= s) {
+                    node++;
                 }
+                stub[bucketOffset[bucket[s]] + bucketFill[chunk][bucket[s]]++] = node;
+            }
+        }
+    });
+    std::vector<std::uint16_t>().swap(bucket);
+    parallelFor(0, bucketCount, [&](const int begin, const int end, int) {
+        for (int b = begin; b < end; ++b) {
+            RandomStream local(key, static_cast<std::uint64_t>(chunkCount) + b);
+            for (long long s = bucketOffset[b + 1] - 1; s > bucketOffset[b]; --s) {
+                std::swap(stub[s], stub[bucketOffset[b] + static_cast<long long>(local.nextBelow(s - bucketOffset[b] + 1))]);
             }
         }
-        for (int obj: selected) {
-            ret.addEdge({i, obj, 1.});
-            degreeList[obj] ++;
+    });
+    /* Neighboring stubs pair up, self-loops are dropped and repeated pairs merge into one heavier edge. */
+    std::vector<std::tuple<int, int, double>> edges;
+    edges.reserve(stubCount / 2);
+    for (long long s = 0; s < stubCount; s += 2) {
+        if (stub[s] != stub[s + 1]) {
+            edges.emplace_back(stub[s], stub[s + 1], 1.);
+        }
+    }
+    return {nodeCount, edges};
+}
+
+std::vector<int> degreeSequence(const int nodeCount, const std::vector<double>& distribution) {
+    if (nodeCount < 0) {
+        std::cerr << "Cannot sample degrees for " << nodeCount << " node(s)." << std::endl;
+        return std::vector<int>(0);
+    }
+    std::vector<double> cumulative(distribution.size(), 0.);
+    double total = 0.;
+    for (std::size_t k = 0; k < distribution.size(); ++k) {
+        if (distribution[k] < 0.) {
+            std::cerr << "Degree distribution cannot have NEGATIVE probability " << distribution[k] << " at degree " << k << "." << std::endl;
+            return std::vector<int>(0);
         }
-        degreeList.push_back(averageDegree);
+        cumulative[k] = total += distribution[k];
+    }
+    if (total <= 0.) {
+        std::cerr << "Degree distribution is empty." << std::endl;
+        return std::vector<int>(0);
+    }
+    const std::uint64_t key = gen.next64();
+    constexpr int chunkNodes = 1 << 16;
+    std::vector<int> degrees(nodeCount);
+    parallelFor(0, (nodeCount + chunkNodes - 1) / chunkNodes, [&](const int begin, const int end, int) {
+        for (int chunk = begin; chunk < end; ++chunk) {
+            RandomStream local(key, chunk);
+            for (int i = chunk * chunkNodes; i < std::min(nodeCount, (chunk + 1) * chunkNodes); ++i) {
+                const auto k = std::ranges::upper_bound(cumulative, local.nextDouble() * total) - cumulative.begin();
+                degrees[i] = static_cast<int>(std::min<std::ptrdiff_t>(k, static_cast<std::ptrdiff_t>(cumulative.size()) - 1));
+            }
+        }
+    });
+    long long sum = 0;
+    for (const int degree: degrees) {
+        sum += degree;
+    }
+    if ((sum & 1) && nodeCount) {
+        degrees[nodeCount - 1]++; // Stubs have to pair up.
     }
-    return ret;
+    return degrees;
 }
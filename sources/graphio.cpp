@@ -0,0 +1,1111 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <atomic>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "../headers/graphio.h"
+#include "../headers/algorithm.h"
+#include "../headers/parallel.h"
+#include "../headers/stats.h"
+
+MappedFile::MappedFile(const std::string& fileName) : begin(nullptr), length(0), opened(false) {
+#ifdef _WIN32
+    this->mapping = nullptr;
+    this->file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    LARGE_INTEGER fileSize;
+    if (this->file == INVALID_HANDLE_VALUE || !GetFileSizeEx(this->file, &fileSize)) {
+        return;
+    }
+    this->opened = true;
+    this->length = static_cast<std::size_t>(fileSize.QuadPart);
+    if (!this->length) {
+        return;
+    }
+    this->mapping = CreateFileMappingA(this->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (this->mapping) {
+        this->begin = static_cast<const char*>(MapViewOfFile(this->mapping, FILE_MAP_READ, 0, 0, 0));
+    }
+#else
+    this->descriptor = open(fileName.c_str(), O_RDONLY);
+    struct stat status{};
+    if (this->descriptor < 0 || fstat(this->descriptor, &status) != 0) {
+        return;
+    }
+    this->opened = true;
+    this->length = static_cast<std::size_t>(status.st_size);
+    if (!this->length) {
+        return;
+    }
+    void* view = mmap(nullptr, this->length, PROT_READ, MAP_PRIVATE, this->descriptor, 0);
+    if (view != MAP_FAILED) {
+        madvise(view, this->length, MADV_SEQUENTIAL);
+        this->begin = static_cast<const char*>(view);
+    }
+#endif
+    if (!this->begin) {
+        this->opened = false; // Cannot be mapped, e.g. a directory.
+        this->length = 0;
+    }
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+    if (this->begin) {
+        UnmapViewOfFile(this->begin);
+    }
+    if (this->mapping) {
+        CloseHandle(this->mapping);
+    }
+    if (this->file != INVALID_HANDLE_VALUE) {
+        CloseHandle(this->file);
+    }
+#else
+    if (this->begin) {
+        munmap(const_cast<char*>(this->begin), this->length);
+    }
+    if (this->descriptor >= 0) {
+        close(this->descriptor);
+    }
+#endif
+}
+
+bool MappedFile::isOpen() const {
+    return this->opened;
+}
+
+const char* MappedFile::data() const {
+    return this->begin;
+}
+
+std::size_t MappedFile::size() const {
+    return this->length;
+}
+
+static constexpr int reportedErrors = 10;
+
+namespace {
+    /* Cursor over one line, numbers may be surrounded by blanks. */
+    struct LineReader {
+        const char* cur;
+        const char* end;
+
+        void skipBlank() {
+            while (cur < end && (*cur == ' ' || *cur == '\t' || *cur == '\r')) {
+                ++cur;
+            }
+        }
+
+        template <typename Number>
+        bool number(Number& value) {
+            skipBlank();
+            const auto [ptr, ec] = std::from_chars(cur, end, value);
+            cur = ptr;
+            return ec == std::errc();
+        }
+
+        bool separator() {
+            skipBlank();
+            if (cur < end && *cur == ',') {
+                ++cur;
+                return true;
+            }
+            return false;
+        }
+
+        bool finished() {
+            skipBlank();
+            return cur == end;
+        }
+
+        /* Blank line or a line starting with `mark`, e.g. '#' of SNAP or '%' of Matrix Market and METIS. */
+        bool comment(const char mark) {
+            skipBlank();
+            return cur == end || *cur == mark;
+        }
+
+        /* Next blank separated word, lower-cased. */
+        std::string word() {
+            skipBlank();
+            std::string text;
+            for (; cur < end && *cur != ' ' && *cur != '\t' && *cur != '\r'; ++cur) {
+                text += static_cast<char>(std::tolower(static_cast<unsigned char>(*cur)));
+            }
+            return text;
+        }
+    };
+
+    struct Chunk {
+        std::vector<std::tuple<int, int, double>> edges;
+        long long lines = 0, rows = 0, errorCount = 0; // `rows` counts the node rows of METIS.
+        int minId = INT_MAX, maxId = -1; // Over the edge ends, for SNAP id normalization.
+        std::vector<std::pair<long long, std::string_view>> errors; // (line inside the chunk, reason), only the first few.
+
+        void fail(const std::string_view reason) {
+            if (errors.size() < reportedErrors) {
+                errors.emplace_back(lines, reason);
+            }
+            errorCount++;
+        }
+    };
+}
+
+/* The part of [begin, end) after the first line end, or `end` if there is none. */
+static const char* nextLine(const char* begin, const char* end) {
+    const void* found = std::memchr(begin, '\n', end - begin);
+    return found ? static_cast<const char*>(found) + 1 : end;
+}
+
+/* End of the line [begin, next) without its line end. */
+static const char* lineEnd(const char* begin, const char* next) {
+    return next > begin && next[-1] == '\n' ? next - 1 : next;
+}
+
+/* Skips the lines accepted by `skip` at `line`, counting them into `lineCount`. */
+template <typename Skip>
+static const char* skipLines(const char* line, const char* end, long long& lineCount, const Skip& skip) {
+    while (line < end) {
+        const char* next = nextLine(line, end);
+        LineReader reader{line, lineEnd(line, next)};
+        if (!skip(reader)) {
+            break;
+        }
+        line = next;
+        lineCount++;
+    }
+    return line;
+}
+
+template <typename Parse>
+static void parseRange(const char* begin, const char* end, Chunk& chunk, const Parse& parse) {
+    chunk.edges.reserve((end - begin) / 12); // About the shortest realistic line.
+    for (const char* line = begin; line < end; chunk.lines++) {
+        const char* next = nextLine(line, end);
+        LineReader reader{line, lineEnd(line, next)};
+        line = next;
+        parse(reader, chunk);
+    }
+}
+
+/* Cuts [body, end) into one chunk per thread, every cut moved forward to a line start, and hands every line of a chunk
+ * to `parse(reader, chunk)` on its own thread. */
+template <typename Parse>
+static std::vector<Chunk> parseLines(const char* body, const char* end, const Parse& parse) {
+    const std::size_t bodySize = end - body;
+    const int workers = std::max(1, static_cast<int>(std::min<std::size_t>(threadCount(), bodySize / (1 << 16) + 1)));
+    std::vector<const char*> cut(workers + 1, end);
+    cut[0] = body;
+    for (int t = 1; t < workers; ++t) {
+        const char* guess = body + bodySize * t / workers;
+        cut[t] = std::max(cut[t - 1], guess == body ? body : nextLine(guess - 1, end));
+    }
+    std::vector<Chunk> chunks(workers);
+    runWorkers(workers, [&](const int t) {
+        parseRange(cut[t], cut[t + 1], chunks[t], parse);
+    });
+    return chunks;
+}
+
+/* Reports skipped lines in one write, line numbers are known only now: every chunk starts after the lines before it.
+ * Returns the count of skipped lines. */
+static long long reportErrors(const std::vector<Chunk>& chunks, long long firstLine, const std::string& fileName) {
+    std::string report;
+    long long errorCount = 0;
+    for (const Chunk& chunk: chunks) {
+        for (const auto& [line, reason]: chunk.errors) {
+            if (errorCount < reportedErrors) {
+                report += "Line " + std::to_string(firstLine + line) + " of " + fileName + " is skipped, " + std::string(reason) + ".\n";
+            }
+            errorCount++;
+        }
+        errorCount += chunk.errorCount - static_cast<long long>(chunk.errors.size());
+        firstLine += chunk.lines;
+    }
+    if (errorCount > reportedErrors) {
+        report += std::to_string(errorCount - reportedErrors) + " more malformed line(s) of " + fileName + " are skipped.\n";
+    }
+    if (!report.empty()) {
+        std::cerr << report << std::flush;
+    }
+    return errorCount;
+}
+
+/* Concatenates the edges of all chunks in order, `transform` may rewrite every edge of chunk t in place. */
+template <typename Transform>
+static std::vector<std::tuple<int, int, double>> gatherEdges(std::vector<Chunk>& chunks, const Transform& transform) {
+    const int workers = static_cast<int>(chunks.size());
+    std::vector<std::size_t> edgeOffset(workers + 1, 0);
+    for (int t = 0; t < workers; ++t) {
+        edgeOffset[t + 1] = edgeOffset[t] + chunks[t].edges.size();
+    }
+    std::vector<std::tuple<int, int, double>> edges(edgeOffset[workers]);
+    runWorkers(workers, [&](const int t) {
+        auto out = edges.begin() + static_cast<std::ptrdiff_t>(edgeOffset[t]);
+        for (const std::tuple<int, int, double>& edge: chunks[t].edges) {
+            *out = edge;
+            transform(t, *out++);
+        }
+        std::vector<std::tuple<int, int, double>>().swap(chunks[t].edges);
+    });
+    return edges;
+}
+
+static std::vector<std::tuple<int, int, double>> gatherEdges(std::vector<Chunk>& chunks) {
+    return gatherEdges(chunks, [](int, std::tuple<int, int, double>&) {});
+}
+
+/* The "nodeCount,edgeCount,isDirected" line, `declared` stays -1 when it is not a number. */
+static bool parseCsvHeader(LineReader header, int& nodeCount, long long& declared, bool& directed) {
+    if (!header.number(nodeCount) || !header.separator() || !header.number(declared) || !header.separator() || nodeCount < 0) {
+        return false;
+    }
+    header.skipBlank();
+    std::string direct(header.cur, header.end - header.cur);
+    while (!direct.empty() && (direct.back() == ' ' || direct.back() == '\t' || direct.back() == '\r')) {
+        direct.pop_back();
+    }
+    std::ranges::transform(direct, direct.begin(), ::tolower);
+    directed = direct == "true";
+    return true;
+}
+
+static void parseCsvLine(LineReader& reader, Chunk& chunk, const int nodeCount) {
+    if (reader.finished()) {
+        return; // Blank lines, e.g. the end of the file.
+    }
+    int left = -1, right = -1;
+    double weight = 0.;
+    if (!reader.number(left) || !reader.separator() || !reader.number(right) || !reader.separator() || !reader.number(weight) || !reader.finished()) {
+        chunk.fail("it is not \"startNode,endNode,edgeWeight\"");
+        return;
+    }
+    if (left < 0 || left >= nodeCount || right < 0 || right >= nodeCount) {
+        chunk.fail("node index is out of the graph");
+        return;
+    }
+    chunk.edges.emplace_back(left, right, weight);
+}
+
+Graph readCsv(const std::string& fileName) {
+    const MappedFile file(fileName);
+    if (!file.isOpen()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return Graph();
+    }
+    if (!file.size()) {
+        std::cerr << "File " << fileName << " is empty." << std::endl;
+        return Graph();
+    }
+    const char* data = file.data();
+    const char* end = data + file.size();
+    const char* body = nextLine(data, end);
+    int nodeCount = -1;
+    long long declared = -1;
+    bool directed = false;
+    if (!parseCsvHeader({data, lineEnd(data, body)}, nodeCount, declared, directed)) {
+        std::cerr << "Line 1 of " << fileName << " must be \"nodeCount,edgeCount,isDirected\"." << std::endl;
+        return Graph();
+    }
+    std::vector<Chunk> chunks = parseLines(body, end, [nodeCount](LineReader& reader, Chunk& chunk) {
+        parseCsvLine(reader, chunk, nodeCount);
+    });
+    const long long errorCount = reportErrors(chunks, 2, fileName); // The header is line 1.
+    const std::vector<std::tuple<int, int, double>> edges = gatherEdges(chunks);
+    if (declared >= 0 && static_cast<std::size_t>(declared) != edges.size() + errorCount) {
+        std::cout << "File " << fileName << " declares " << declared << " edge(s) but has " << edges.size() + errorCount << " edge line(s), all of them are read." << std::endl;
+    }
+    return Graph(nodeCount, edges, directed);
+}
+
+namespace {
+    struct TextBlock {
+        std::string text; // Whole lines only.
+        long long firstLine = 0;
+    };
+
+    struct EdgeBlock {
+        Chunk chunk;
+        long long firstLine = 0;
+    };
+}
+
+Graph streamCsv(const std::string& fileName, const std::size_t blockSize) {
+    if (!blockSize) {
+        std::cerr << "Cannot stream " << fileName << " in blocks of 0 bytes." << std::endl;
+        return Graph();
+    }
+    std::ifstream ifs(fileName, std::ios::binary);
+    if (!ifs.is_open()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return Graph();
+    }
+    std::string headerLine;
+    if (!std::getline(ifs, headerLine)) {
+        std::cerr << "File " << fileName << " is empty." << std::endl;
+        return Graph();
+    }
+    int nodeCount = -1;
+    long long declared = -1;
+    bool directed = false;
+    if (!parseCsvHeader({headerLine.data(), headerLine.data() + headerLine.size()}, nodeCount, declared, directed)) {
+        std::cerr << "Line 1 of " << fileName << " must be \"nodeCount,edgeCount,isDirected\"." << std::endl;
+        return Graph();
+    }
+    /* Reader -> parsers -> builder, every arrow a bounded ring of blocks. A full ring stalls the stage before it, so
+     * at most a few blocks per parser are in flight whatever the file size, and the slowest stage sets the pace. The
+     * builder appends edge blocks into one list sized by the header, repeated edges merge when the graph is built. */
+    const int parsers = std::max(1, threadCount() - 2);
+    BoundedQueue<TextBlock> texts(2 * parsers);
+    BoundedQueue<EdgeBlock> blocks(2 * parsers);
+    std::atomic<int> parsing(parsers);
+    std::vector<std::tuple<int, int, double>> edges;
+    std::error_code sizeError; // A pipe has no size, the header alone decides then.
+    const std::uintmax_t fileSize = std::filesystem::file_size(fileName, sizeError);
+    edges.reserve(std::min<std::uintmax_t>(std::max(declared, 0LL), sizeError ? UINTMAX_MAX : fileSize / 6)); // A line takes 6 bytes at least.
+    std::vector<std::pair<long long, std::string_view>> errors;
+    long long errorCount = 0;
+    std::size_t edgeTotal = 0;
+    runWorkers(parsers + 2, [&](const int t) {
+        if (t == 1) {
+            long long line = 2; // The header is line 1.
+            std::string carry;
+            while (true) {
+                TextBlock block{std::move(carry), line};
+                carry.clear();
+                const std::size_t kept = block.text.size();
+                block.text.resize(kept + blockSize);
+                ifs.read(block.text.data() + kept, static_cast<std::streamsize>(blockSize));
+                block.text.resize(kept + ifs.gcount());
+                const bool last = !ifs;
+                if (!last) {
+                    const std::size_t cut = block.text.rfind('\n');
+                    if (cut == std::string::npos) {
+                        carry = std::move(block.text); // One line longer than a block, keep reading it.
+                        continue;
+                    }
+                    carry.assign(block.text, cut + 1);
+                    block.text.resize(cut + 1);
+                }
+                if (block.text.empty()) {
+                    break;
+                }
+                line += std::ranges::count(block.text, '\n');
+                texts.push(std::move(block));
+                if (last) {
+                    break;
+                }
+            }
+            texts.close();
+            return;
+        }
+        if (t >= 2) {
+            TextBlock text;
+            while (texts.pop(text)) {
+                EdgeBlock block{Chunk(), text.firstLine};
+                parseRange(text.text.data(), text.text.data() + text.text.size(), block.chunk, [nodeCount](LineReader& reader, Chunk& chunk) {
+                    parseCsvLine(reader, chunk, nodeCount);
+                });
+                blocks.push(std::move(block));
+            }
+            if (parsing.fetch_sub(1) == 1) {
+                blocks.close();
+            }
+            return;
+        }
+        EdgeBlock block;
+        while (blocks.pop(block)) {
+            edges.insert(edges.end(), block.chunk.edges.begin(), block.chunk.edges.end());
+            edgeTotal += block.chunk.edges.size();
+            for (const auto& [line, reason]: block.chunk.errors) {
+                errors.emplace_back(block.firstLine + line, reason);
+            }
+            errorCount += block.chunk.errorCount;
+        }
+    });
+    /* Blocks arrive in any order, the reported lines are sorted afterwards. */
+    std::ranges::sort(errors);
+    std::string report;
+    for (std::size_t k = 0; k < errors.size() && k < reportedErrors; ++k) {
+        report += "Line " + std::to_string(errors[k].first) + " of " + fileName + " is skipped, " + std::string(errors[k].second) + ".\n";
+    }
+    if (errorCount > reportedErrors) {
+        report += std::to_string(errorCount - reportedErrors) + " more malformed line(s) of " + fileName + " are skipped.\n";
+    }
+    if (!report.empty()) {
+        std::cerr << report << std::flush;
+    }
+    if (declared >= 0 && static_cast<std::size_t>(declared) != edgeTotal + errorCount) {
+        std::cout << "File " << fileName << " declares " << declared << " edge(s) but has " << edgeTotal + errorCount << " edge line(s), all of them are read." << std::endl;
+    }
+    return Graph(nodeCount, edges, directed);
+}
+
+Graph readSnap(const std::string& fileName) {
+    const MappedFile file(fileName);
+    if (!file.isOpen()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return Graph();
+    }
+    const char* data = file.data();
+    const char* end = data + file.size();
+    /* Leading comments may say "Directed graph" or "Undirected graph", SNAP edge lists are directed otherwise. */
+    bool directed = true;
+    long long headerLines = 0;
+    const char* body = skipLines(data, end, headerLines, [&directed](LineReader& reader) {
+        if (!reader.comment('#')) {
+            return false;
+        }
+        const std::string_view text(reader.cur, reader.end - reader.cur);
+        if (text.find("Undirected") != std::string_view::npos || text.find("undirected") != std::string_view::npos) {
+            directed = false;
+        }
+        return true;
+    });
+    std::vector<Chunk> chunks = parseLines(body, end, [](LineReader& reader, Chunk& chunk) {
+        if (reader.comment('#')) {
+            return;
+        }
+        int left = -1, right = -1;
+        double weight = 1.;
+        if (!reader.number(left) || !reader.number(right) || (!reader.finished() && !reader.number(weight)) || !reader.finished()) {
+            chunk.fail("it is not \"fromNode toNode [weight]\"");
+            return;
+        }
+        if (left < 0 || right < 0) {
+            chunk.fail("node id is negative");
+            return;
+        }
+        chunk.minId = std::min({chunk.minId, left, right});
+        chunk.maxId = std::max({chunk.maxId, left, right});
+        chunk.edges.emplace_back(left, right, weight);
+    });
+    reportErrors(chunks, headerLines + 1, fileName);
+    int minId = INT_MAX, maxId = -1;
+    for (const Chunk& chunk: chunks) {
+        minId = std::min(minId, chunk.minId);
+        maxId = std::max(maxId, chunk.maxId);
+    }
+    if (maxId < 0) {
+        return Graph(0, directed);
+    }
+    /* Ids without a 0 are taken as 1-based. Ids spread over more than twice the nodes in use are renumbered densely in
+     * ascending order instead (e.g. the sparse user ids of a crawl), ranks come from a bitmap of used ids. */
+    const int base = minId >= 1 ? 1 : 0;
+    std::vector<std::uint64_t> used(static_cast<std::size_t>(maxId) / 64 + 1, 0);
+    runWorkers(static_cast<int>(chunks.size()), [&](const int t) {
+        for (const auto& [left, right, weight]: chunks[t].edges) {
+            std::atomic_ref(used[left / 64]).fetch_or(std::uint64_t(1) << left % 64, std::memory_order_relaxed);
+            std::atomic_ref(used[right / 64]).fetch_or(std::uint64_t(1) << right % 64, std::memory_order_relaxed);
+        }
+    });
+    std::vector<int> rankBefore(used.size() + 1, 0);
+    for (std::size_t w = 0; w < used.size(); ++w) {
+        rankBefore[w + 1] = rankBefore[w] + std::popcount(used[w]);
+    }
+    const bool renumber = static_cast<long long>(maxId) - base + 1 > 2LL * rankBefore.back();
+    const int nodeCount = renumber ? rankBefore.back() : maxId - base + 1;
+    if (renumber) {
+        std::cout << "Node ids of " << fileName << " spread over [" << minId << ", " << maxId << "], the " << nodeCount << " used id(s) are renumbered from 0 in ascending order." << std::endl;
+    } else if (base) {
+        std::cout << "Node ids of " << fileName << " start from 1, they are taken as 1-based and shifted to start from 0." << std::endl;
+    }
+    const auto normalize = [&](const int id) {
+        return renumber ? rankBefore[id / 64] + std::popcount(used[id / 64] & ((std::uint64_t(1) << id % 64) - 1)) : id - base;
+    };
+    std::vector<std::tuple<int, int, double>> edges = gatherEdges(chunks, [&normalize](int, std::tuple<int, int, double>& edge) {
+        std::get<0>(edge) = normalize(std::get<0>(edge));
+        std::get<1>(edge) = normalize(std::get<1>(edge));
+    });
+    if (!directed) {
+        /* Undirected SNAP files mostly list every edge from both ends, which would double its weight. Like METIS, the
+         * copy from the smaller end is kept, but a copy from the larger end is only dropped when its mirror is there,
+         * since other files list every edge once in either direction. */
+        std::vector<std::pair<int, int>> forward;
+        for (const auto& [left, right, weight]: edges) {
+            if (left < right) {
+                forward.emplace_back(left, right);
+            }
+        }
+        std::ranges::sort(forward);
+        std::erase_if(edges, [&forward](const std::tuple<int, int, double>& edge) {
+            return std::get<0>(edge) > std::get<1>(edge) && std::ranges::binary_search(forward, std::make_pair(std::get<1>(edge), std::get<0>(edge)));
+        });
+    }
+    return Graph(nodeCount, edges, directed);
+}
+
+Graph readMatrixMarket(const std::string& fileName) {
+    const MappedFile file(fileName);
+    if (!file.isOpen()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return Graph();
+    }
+    const char* data = file.data();
+    const char* end = data + file.size();
+    const char* line = nextLine(data, end);
+    LineReader banner{data, lineEnd(data, line)};
+    const std::string mark = banner.word(), object = banner.word(), format = banner.word(), field = banner.word(), symmetry = banner.word();
+    if (mark != "%%matrixmarket" || object != "matrix") {
+        std::cerr << "Line 1 of " << fileName << " must be \"%%MatrixMarket matrix coordinate field symmetry\"." << std::endl;
+        return Graph();
+    }
+    if (format != "coordinate" || (field != "real" && field != "integer" && field != "pattern" && field != "double") || (symmetry != "general" && symmetry != "symmetric" && symmetry != "skew-symmetric" && symmetry != "hermitian")) {
+        std::cerr << "Matrix Market " << format << ' ' << field << ' ' << symmetry << " of " << fileName << " is not supported, only a real, integer or pattern coordinate matrix is." << std::endl;
+        return Graph();
+    }
+    long long headerLines = 1;
+    line = skipLines(line, end, headerLines, [](LineReader& reader) {
+        return reader.comment('%');
+    });
+    const char* body = nextLine(line, end);
+    LineReader size{line, lineEnd(line, body)};
+    int rowCount = -1, columnCount = -1;
+    long long declared = -1;
+    if (!size.number(rowCount) || !size.number(columnCount) || !size.number(declared) || !size.finished() || rowCount < 0 || columnCount < 0) {
+        std::cerr << "Line " << headerLines + 1 << " of " << fileName << " must be \"rows columns entries\"." << std::endl;
+        return Graph();
+    }
+    /* Node count is the larger side. A symmetric (or real hermitian) matrix keeps only one triangle, which is exactly an
+     * undirected edge list, a skew-symmetric one is mirrored with negated weights into a directed graph. */
+    const bool pattern = field == "pattern", skew = symmetry == "skew-symmetric";
+    const bool directed = symmetry == "general" || skew;
+    std::vector<Chunk> chunks = parseLines(body, end, [=](LineReader& reader, Chunk& chunk) {
+        if (reader.comment('%')) {
+            return;
+        }
+        int row = 0, column = 0;
+        double value = 1.;
+        if (!reader.number(row) || !reader.number(column) || (!pattern && !reader.number(value)) || !reader.finished()) {
+            chunk.fail(pattern ? "it is not \"row column\"" : "it is not \"row column value\"");
+            return;
+        }
+        if (row < 1 || row > rowCount || column < 1 || column > columnCount) {
+            chunk.fail("entry is out of the matrix");
+            return;
+        }
+        chunk.edges.emplace_back(row - 1, column - 1, value);
+        if (skew && row != column) {
+            chunk.edges.emplace_back(column - 1, row - 1, -value);
+        }
+    });
+    const long long errorCount = reportErrors(chunks, headerLines + 2, fileName);
+    const std::vector<std::tuple<int, int, double>> edges = gatherEdges(chunks);
+    const std::size_t entries = skew ? std::ranges::count_if(edges, [](const std::tuple<int, int, double>& edge) {
+        return std::get<0>(edge) <= std::get<1>(edge);
+    }) : edges.size();
+    if (static_cast<std::size_t>(declared) != entries + errorCount) {
+        std::cout << "File " << fileName << " declares " << declared << " entries but has " << entries + errorCount << " entry line(s), all of them are read." << std::endl;
+    }
+    return Graph(std::max(rowCount, columnCount), edges, directed);
+}
+
+Graph readMetis(const std::string& fileName) {
+    const MappedFile file(fileName);
+    if (!file.isOpen()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return Graph();
+    }
+    const char* data = file.data();
+    const char* end = data + file.size();
+    long long headerLines = 0;
+    const char* line = skipLines(data, end, headerLines, [](LineReader& reader) {
+        return reader.comment('%');
+    });
+    const char* body = nextLine(line, end);
+    LineReader header{line, lineEnd(line, body)};
+    int nodeCount = -1, constraints = 1;
+    long long declared = -1;
+    std::string format;
+    if (!header.number(nodeCount) || !header.number(declared) || nodeCount < 0) {
+        std::cerr << "Line " << headerLines + 1 << " of " << fileName << " must be \"nodeCount edgeCount [format [constraints]]\"." << std::endl;
+        return Graph();
+    }
+    format = header.word();
+    if (!header.finished() && (!header.number(constraints) || !header.finished())) {
+        std::cerr << "Line " << headerLines + 1 << " of " << fileName << " must be \"nodeCount edgeCount [format [constraints]]\"." << std::endl;
+        return Graph();
+    }
+    /* `format` is up to three flags "[sizes][node weights][edge weights]", node sizes and weights are skipped. */
+    format.insert(0, 3 - std::min<std::size_t>(3, format.size()), '0');
+    if (format.size() != 3 || std::ranges::any_of(format, [](const char c) { return c != '0' && c != '1'; })) {
+        std::cerr << "Format " << format << " of " << fileName << " is not a METIS format." << std::endl;
+        return Graph();
+    }
+    const bool sized = format[0] == '1', edgeWeighted = format[2] == '1';
+    const int nodeWeights = format[1] == '1' ? constraints : 0;
+    /* Line k (not counting comments) is the neighbor list of node k, so rows are local to a chunk until the rows before
+     * it are counted. Every edge is listed by both ends, only the copy from the smaller end is kept. */
+    std::vector<Chunk> chunks = parseLines(body, end, [=](LineReader& reader, Chunk& chunk) {
+        reader.skipBlank();
+        if (reader.cur < reader.end && *reader.cur == '%') {
+            return; // Blank lines are nodes without neighbors, so only comments are skipped here.
+        }
+        const int row = static_cast<int>(chunk.rows++);
+        long long skipped = 0;
+        for (int k = 0; k < sized + nodeWeights; ++k) {
+            if (!reader.number(skipped)) {
+                chunk.fail("node size or weight is missing");
+                return;
+            }
+        }
+        while (!reader.finished()) {
+            int neighbor = 0;
+            double weight = 1.;
+            if (!reader.number(neighbor) || (edgeWeighted && !reader.number(weight))) {
+                chunk.fail(edgeWeighted ? "it is not \"neighbor weight\" pairs" : "it is not a neighbor list");
+                return;
+            }
+            if (neighbor < 1 || neighbor > nodeCount) {
+                chunk.fail("node index is out of the graph");
+                return;
+            }
+            chunk.edges.emplace_back(row, neighbor - 1, weight);
+        }
+    });
+    reportErrors(chunks, headerLines + 2, fileName);
+    std::vector<int> firstRow(chunks.size() + 1, 0);
+    for (std::size_t t = 0; t < chunks.size(); ++t) {
+        firstRow[t + 1] = firstRow[t] + static_cast<int>(chunks[t].rows);
+    }
+    const int rowTotal = firstRow.back();
+    std::vector<std::tuple<int, int, double>> edges = gatherEdges(chunks, [&firstRow](const int t, std::tuple<int, int, double>& edge) {
+        std::get<0>(edge) += firstRow[t];
+    });
+    const std::size_t extra = std::erase_if(edges, [nodeCount](const std::tuple<int, int, double>& edge) {
+        return std::get<0>(edge) >= nodeCount;
+    });
+    std::erase_if(edges, [](const std::tuple<int, int, double>& edge) {
+        return std::get<0>(edge) > std::get<1>(edge);
+    });
+    if (rowTotal < nodeCount || extra) {
+        std::cout << "File " << fileName << " declares " << nodeCount << " node(s) but has " << rowTotal << " row(s), missing rows have no neighbor and extra rows are dropped." << std::endl;
+    }
+    if (static_cast<std::size_t>(declared) != edges.size()) {
+        std::cout << "File " << fileName << " declares " << declared << " edge(s) but has " << edges.size() << ", every edge should be listed by both ends." << std::endl;
+    }
+    return Graph(nodeCount, edges, false);
+}
+
+namespace {
+    struct BinaryHeader {
+        char magic[8];
+        std::uint32_t version, flags;
+        std::int64_t nodeCount, edgeCount;
+        std::uint64_t entryCount, checksum, reserved[2];
+    };
+    static_assert(sizeof(BinaryHeader) == 64);
+
+    /* Buffers the payload and hashes it block by block on the way out, the reader hashes the same blocks in parallel. */
+    class ChecksumWriter {
+    private:
+        std::ofstream& ofs;
+        std::vector<char> buffer;
+        std::size_t used = 0;
+        std::uint64_t block = 0, checksum = 0;
+
+    public:
+        explicit ChecksumWriter(std::ofstream& ofs);
+        void write(const void* bytes, std::size_t size);
+        std::uint64_t finish();
+    };
+}
+
+static constexpr char binaryMagic[8] = {'G', 'E', 'G', 'R', 'A', 'P', 'H', '\0'};
+static constexpr std::uint32_t binaryVersion = 1, directedFlag = 1, weightedFlag = 2;
+static constexpr std::size_t checksumBlock = 1 << 20;
+
+static std::uint64_t mixWord(std::uint64_t hash, const std::uint64_t word) {
+    hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ hash >> 29;
+}
+
+static std::uint64_t blockHash(const char* bytes, const std::size_t size, const std::uint64_t block) {
+    std::uint64_t hash = mixWord(0x243F6A8885A308D3ULL, block), word;
+    std::size_t k = 0;
+    for (; k + 8 <= size; k += 8) {
+        std::memcpy(&word, bytes + k, 8);
+        hash = mixWord(hash, word);
+    }
+    if (k < size) {
+        word = 0;
+        std::memcpy(&word, bytes + k, size - k);
+        hash = mixWord(hash, word);
+    }
+    return mixWord(hash, size);
+}
+
+ChecksumWriter::ChecksumWriter(std::ofstream& ofs) : ofs(ofs), buffer(checksumBlock) {}
+
+void ChecksumWriter::write(const void* bytes, std::size_t size) {
+    const char* from = static_cast<const char*>(bytes);
+    while (size) {
+        const std::size_t part = std::min(size, checksumBlock - this->used);
+        std::memcpy(this->buffer.data() + this->used, from, part);
+        this->used += part;
+        from += part;
+        size -= part;
+        if (this->used == checksumBlock) {
+            this->finish();
+        }
+    }
+}
+
+std::uint64_t ChecksumWriter::finish() {
+    if (this->used) {
+        this->checksum = mixWord(this->checksum, blockHash(this->buffer.data(), this->used, this->block++));
+        this->ofs.write(this->buffer.data(), static_cast<std::streamsize>(this->used));
+        this->used = 0;
+    }
+    return this->checksum;
+}
+
+bool saveBinary(const Graph& graph, const std::string& fileName) {
+    std::ofstream ofs(fileName, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << fileName << " to save the binary graph." << std::endl;
+        return false;
+    }
+    const int nodeCount = graph.getNodeCount();
+    std::vector<std::uint64_t> offset(nodeCount + 1, 0);
+    bool weighted = false;
+    for (int i = 0; i < nodeCount; ++i) {
+        offset[i + 1] = offset[i] + graph.getNeighbors(i).size();
+        weighted = weighted || std::ranges::any_of(graph.getNeighbors(i), [](const std::pair<int, double>& entry) { return entry.second != 1.; });
+    }
+    BinaryHeader header{};
+    std::memcpy(header.magic, binaryMagic, sizeof(binaryMagic));
+    header.version = binaryVersion;
+    header.flags = (graph.isDirected() ? directedFlag : 0) | (weighted ? weightedFlag : 0);
+    header.nodeCount = nodeCount;
+    header.edgeCount = graph.getEdgeCount();
+    header.entryCount = offset[nodeCount];
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    ChecksumWriter writer(ofs);
+    writer.write(offset.data(), offset.size() * sizeof(std::uint64_t));
+    std::vector<int> targets;
+    for (int i = 0; i < nodeCount; ++i) {
+        targets.clear();
+        for (const auto& [neighbor, w]: graph.getNeighbors(i)) {
+            targets.push_back(neighbor);
+        }
+        writer.write(targets.data(), targets.size() * sizeof(int));
+    }
+    if (header.entryCount & 1) {
+        constexpr int padding = 0;
+        writer.write(&padding, sizeof(int)); // Weights stay 8-byte aligned.
+    }
+    if (weighted) {
+        std::vector<double> weights;
+        for (int i = 0; i < nodeCount; ++i) {
+            weights.clear();
+            for (const auto& [neighbor, w]: graph.getNeighbors(i)) {
+                weights.push_back(w);
+            }
+            writer.write(weights.data(), weights.size() * sizeof(double));
+        }
+    }
+    header.checksum = writer.finish();
+    ofs.seekp(0);
+    ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(ofs);
+}
+
+GraphView::GraphView() : directed(false), weighted(false), nodeCount(0), edgeCount(0), offset(nullptr), target(nullptr), weight(nullptr) {}
+
+GraphView::GraphView(const std::string& fileName, const bool verify) : GraphView() {
+    auto mapped = std::make_shared<const MappedFile>(fileName);
+    if (!mapped->isOpen()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return;
+    }
+    BinaryHeader header{};
+    if (mapped->size() < sizeof(header)) {
+        std::cerr << "File " << fileName << " is not a binary graph." << std::endl;
+        return;
+    }
+    std::memcpy(&header, mapped->data(), sizeof(header));
+    if (std::memcmp(header.magic, binaryMagic, sizeof(binaryMagic)) != 0) {
+        std::cerr << "File " << fileName << " is not a binary graph." << std::endl;
+        return;
+    }
+    if (header.version != binaryVersion) {
+        std::cerr << "Binary graph " << fileName << " has version " << header.version << ", only version " << binaryVersion << " is supported." << std::endl;
+        return;
+    }
+    const std::uint64_t entries = header.entryCount;
+    const std::uint64_t targetBytes = (entries + (entries & 1)) * sizeof(int);
+    const std::uint64_t expected = sizeof(header) + (static_cast<std::uint64_t>(header.nodeCount) + 1) * sizeof(std::uint64_t) + targetBytes + (header.flags & weightedFlag ? entries * sizeof(double) : 0);
+    if (header.nodeCount < 0 || header.nodeCount > INT32_MAX || mapped->size() != expected) {
+        std::cerr << "Binary graph " << fileName << " is truncated or broken." << std::endl;
+        return;
+    }
+    const char* payload = mapped->data() + sizeof(header);
+    const auto* offsets = reinterpret_cast<const std::uint64_t*>(payload);
+    const auto* targets = reinterpret_cast<const int*>(payload + (header.nodeCount + 1) * sizeof(std::uint64_t));
+    const auto* weights = header.flags & weightedFlag ? reinterpret_cast<const double*>(reinterpret_cast<const char*>(targets) + targetBytes) : nullptr;
+    const int nc = static_cast<int>(header.nodeCount);
+    /* Rows must tile the neighbor array, or a span of a node would reach out of the file. This reads only the
+     * offsets, so it runs on every open, the neighbor ids are left to `verify`. */
+    std::vector<char> broken(std::max(1, std::min(threadCount(), nc)), 0);
+    parallelFor(0, nc, [&](const int begin, const int end, const int t) {
+        for (int i = begin; i < end; ++i) {
+            if (offsets[i] > offsets[i + 1]) {
+                broken[t] = 1;
+                break;
+            }
+        }
+    });
+    if (offsets[0] != 0 || offsets[nc] != entries || std::ranges::any_of(broken, [](const char b) { return b != 0; })) {
+        std::cerr << "Binary graph " << fileName << " has broken row offsets." << std::endl;
+        return;
+    }
+    if (verify) {
+        /* Blocks are hashed on all threads and combined in order, rows are checked for sorted in-range ids. */
+        const std::size_t payloadSize = mapped->size() - sizeof(header);
+        const int blocks = static_cast<int>((payloadSize + checksumBlock - 1) / checksumBlock);
+        std::vector<std::uint64_t> hash(blocks);
+        parallelFor(0, blocks, [&](const int begin, const int end, int) {
+            for (int b = begin; b < end; ++b) {
+                const std::size_t from = static_cast<std::size_t>(b) * checksumBlock;
+                hash[b] = blockHash(payload + from, std::min(checksumBlock, payloadSize - from), b);
+            }
+        });
+        std::uint64_t checksum = 0;
+        for (const std::uint64_t h: hash) {
+            checksum = mixWord(checksum, h);
+        }
+        if (checksum != header.checksum) {
+            std::cerr << "Binary graph " << fileName << " does not match its checksum." << std::endl;
+            return;
+        }
+        parallelFor(0, nc, [&](const int begin, const int end, const int t) {
+            for (int i = begin; i < end && !broken[t]; ++i) {
+                for (std::uint64_t k = offsets[i]; k < offsets[i + 1]; ++k) {
+                    if (targets[k] < 0 || targets[k] >= nc || (k > offsets[i] && targets[k - 1] >= targets[k])) {
+                        broken[t] = 1;
+                        break;
+                    }
+                }
+            }
+        });
+        if (std::ranges::any_of(broken, [](const char b) { return b != 0; })) {
+            std::cerr << "Binary graph " << fileName << " has neighbor ids out of the graph or out of order." << std::endl;
+            return;
+        }
+    }
+    this->file = std::move(mapped);
+    this->directed = header.flags & directedFlag;
+    this->weighted = header.flags & weightedFlag;
+    this->nodeCount = nc;
+    this->edgeCount = static_cast<int>(header.edgeCount);
+    this->offset = offsets;
+    this->target = targets;
+    this->weight = weights;
+}
+
+bool GraphView::isDirected() const {
+    return this->directed;
+}
+
+bool GraphView::isWeighted() const {
+    return this->weighted;
+}
+
+int GraphView::getNodeCount() const {
+    return this->nodeCount;
+}
+
+int GraphView::getEdgeCount() const {
+    return this->edgeCount;
+}
+
+std::span<const int> GraphView::getNeighbors(const int nodeIndex) const {
+    if (nodeIndex < 0 || nodeIndex >= this->nodeCount) {
+        std::cerr << "Can not get " << nodeIndex << "th node in " << this->nodeCount << "node(s) graph." << std::endl;
+        return {};
+    }
+    return {this->target + this->offset[nodeIndex], this->target + this->offset[nodeIndex + 1]};
+}
+
+std::span<const double> GraphView::getWeights(const int nodeIndex) const {
+    if (nodeIndex < 0 || nodeIndex >= this->nodeCount) {
+        std::cerr << "Can not get " << nodeIndex << "th node in " << this->nodeCount << "node(s) graph." << std::endl;
+        return {};
+    }
+    if (!this->weighted) {
+        return {};
+    }
+    return {this->weight + this->offset[nodeIndex], this->weight + this->offset[nodeIndex + 1]};
+}
+
+/* Every id is read for the copy anyway, so ids out of the graph are caught here even without `verify`. */
+Graph GraphView::toGraph() const {
+    std::atomic<bool> outside(false);
+    Graph graph(this->nodeCount, [this, &outside](const int i, std::vector<std::pair<int, double>>& row) {
+        row.resize(this->offset[i + 1] - this->offset[i]);
+        for (std::uint64_t k = this->offset[i]; k < this->offset[i + 1]; ++k) {
+            if (this->target[k] < 0 || this->target[k] >= this->nodeCount) {
+                outside.store(true, std::memory_order_relaxed);
+            }
+            row[k - this->offset[i]] = {this->target[k], this->weighted ? this->weight[k] : 1.};
+        }
+    }, this->directed);
+    if (outside.load()) {
+        std::cerr << "Binary graph has neighbor ids out of its " << this->nodeCount << " node(s), nothing is converted." << std::endl;
+        return Graph();
+    }
+    return graph;
+}
+
+static constexpr int rowBlock = 64; // Rows formatted by a worker at once.
+
+template <typename Number>
+static void appendNumber(std::string& out, const Number value) {
+    char text[32];
+    const auto [ptr, ec] = std::to_chars(text, text + sizeof(text), value); // Shortest form, it reads back exactly.
+    out.append(text, ptr);
+}
+
+/* Rows are formatted by `format(row, out, scratch)` in blocks on all threads and written strictly in order by the
+ * calling thread with one large write per block. At most a few blocks per worker wait in memory, so writing
+ * overlaps with formatting and memory does not grow with the file. */
+template <typename Scratch, typename Format>
+static bool writeRows(std::ofstream& ofs, const int rowCount, Format&& format) {
+    const int blocks = (rowCount + rowBlock - 1) / rowBlock;
+    const int workers = std::max(1, std::min(threadCount(), blocks));
+    const int window = 4 * workers;
+    std::vector<std::string> slot(window);
+    std::vector<char> ready(window, 0);
+    int nextBlock = 0, written = 0;
+    std::mutex lock;
+    std::condition_variable changed;
+    std::jthread pool([&]() {
+        runWorkers(workers, [&](int) {
+            Scratch scratch;
+            std::string text;
+            while (true) {
+                int block;
+                {
+                    std::unique_lock guard(lock);
+                    changed.wait(guard, [&]() { return nextBlock >= blocks || nextBlock < written + window; });
+                    if (nextBlock >= blocks) {
+                        return;
+                    }
+                    block = nextBlock++;
+                }
+                text.clear();
+                for (int row = block * rowBlock; row < std::min(rowCount, (block + 1) * rowBlock); ++row) {
+                    format(row, text, scratch);
+                }
+                {
+                    std::lock_guard guard(lock);
+                    slot[block % window].swap(text);
+                    ready[block % window] = 1;
+                }
+                changed.notify_all();
+            }
+        });
+    });
+    std::string text;
+    for (int block = 0; block < blocks; ++block) {
+        {
+            std::unique_lock guard(lock);
+            changed.wait(guard, [&]() { return ready[block % window] != 0; });
+            text.swap(slot[block % window]);
+            ready[block % window] = 0;
+            written = block + 1;
+        }
+        changed.notify_all();
+        ofs.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+    return static_cast<bool>(ofs);
+}
+
+bool exportNodes(const Graph& graph, const std::string& fileName) {
+    std::ofstream ofs(fileName, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << fileName << " to export nodes." << std::endl;
+        return false;
+    }
+    const int nodeCount = graph.getNodeCount();
+    std::string head = "nodeIndex,reachNodeCount,degreeDistribution";
+    for (int i = 0; i < nodeCount; ++i) {
+        head += ",distanceTo" + std::to_string(i) + "thNode";
+    }
+    head += '\n';
+    ofs.write(head.data(), static_cast<std::streamsize>(head.size()));
+    const std::vector<double> degree = degreeDistribution(graph).second;
+    bool unit = true, negative = false;
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            unit = unit && weight == 1.;
+            negative = negative || weight < 0.;
+        }
+    }
+    /* Negative weights need the whole Floyd Warshall matrix, otherwise every row is one search, done as it is written. */
+    const std::vector<std::vector<double>> matrix = negative ? floyd(graph) : std::vector<std::vector<double>>(0);
+    return writeRows<std::vector<double>>(ofs, nodeCount, [&](const int i, std::string& out, std::vector<double>& dist) {
+        if (negative) {
+            dist = matrix[i];
+        } else {
+            distanceRow(graph, i, dist, unit);
+        }
+        int reach = 0;
+        for (int j = 0; j < nodeCount; ++j) {
+            reach += j != i && dist[j] != unreachable;
+        }
+        appendNumber(out, i);
+        out += ',';
+        appendNumber(out, reach);
+        out += ',';
+        appendNumber(out, degree[i]);
+        for (const double d: dist) {
+            out += ',';
+            appendNumber(out, d);
+        }
+        out += '\n';
+    });
+}
+
+bool exportEdges(const Graph& graph, const std::string& fileName) {
+    std::ofstream ofs(fileName, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << fileName << " to export edges." << std::endl;
+        return false;
+    }
+    const std::string head = std::to_string(graph.getNodeCount()) + "," + std::to_string(graph.getEdgeCount()) + (graph.isDirected() ? ",True\n" : ",False\n");
+    ofs.write(head.data(), static_cast<std::streamsize>(head.size()));
+    return writeRows<char>(ofs, graph.getNodeCount(), [&graph](const int i, std::string& out, char) {
+        const int limit = graph.isDirected() ? graph.getNodeCount() : i; // Undirected edges once, from the larger end.
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (neighbor >= limit) {
+                break;
+            }
+            appendNumber(out, i);
+            out += ',';
+            appendNumber(out, neighbor);
+            out += ',';
+            appendNumber(out, weight);
+            out += '\n';
+        }
+    });
+}
@@ -0,0 +1,190 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "../headers/oracle.h"
+#include "../headers/parallel.h"
+
+static constexpr char oracleMagic[8] = {'G', 'E', 'O', 'R', 'A', 'C', 'L', '1'};
+
+DistanceOracle::DistanceOracle() : nodeCount(0) {
+    this->labelOffset = std::vector<std::size_t>(1, 0);
+}
+
+DistanceOracle::DistanceOracle(const Graph& graph) : DistanceOracle() {
+    if (graph.isDirected()) {
+        std::cerr << "Distance oracle only supports undirected graph." << std::endl;
+        return;
+    }
+    const int nc = graph.getNodeCount();
+    /* Landmarks in degree-descending order, high-degree hubs prune most of the later searches. */
+    std::vector<int> order(nc);
+    for (int i = 0; i < nc; ++i) {
+        order[i] = i;
+    }
+    std::ranges::stable_sort(order, [&graph](const int left, const int right) {
+        return graph.getNeighbors(left).size() > graph.getNeighbors(right).size();
+    });
+    std::vector<std::vector<std::pair<int, int>>> labels(nc); // (landmark rank, hop distance)
+    const int workers = std::max(1, std::min(threadCount(), nc));
+    std::vector<std::vector<std::pair<int, std::pair<int, int>>>> found(workers); // (node, label entry)
+    std::vector<std::vector<int>> hubDistance(workers), visitDistance(workers);
+    /* A batch of landmarks runs at once, each pruned only by labels of earlier batches. That keeps every label
+     * exact (no hub of an earlier batch can be skipped), it just prunes a little less than one by one. */
+    for (int batch = 0; batch < nc; batch += workers) {
+        const int batchEnd = std::min(nc, batch + workers);
+        runWorkers(batchEnd - batch, [&](const int t) {
+            const int rank = batch + t, landmark = order[rank];
+            std::vector<int>& hub = hubDistance[t];
+            std::vector<int>& visit = visitDistance[t];
+            hub.resize(nc, INT_MAX);
+            visit.resize(nc, INT_MAX);
+            found[t].clear();
+            for (const auto& [h, d]: labels[landmark]) {
+                hub[h] = d;
+            }
+            std::vector<int> queue(1, landmark);
+            visit[landmark] = 0;
+            for (std::size_t head = 0; head < queue.size(); ++head) {
+                const int u = queue[head], d = visit[u];
+                bool covered = false;
+                for (const auto& [h, du]: labels[u]) {
+                    if (hub[h] != INT_MAX && hub[h] + du <= d) {
+                        covered = true;
+                        break;
+                    }
+                }
+                if (covered) {
+                    continue;
+                }
+                found[t].push_back({u, {rank, d}});
+                for (const auto& [neighbor, weight]: graph.getNeighbors(u)) {
+                    if (visit[neighbor] == INT_MAX) {
+                        visit[neighbor] = d + 1;
+                        queue.push_back(neighbor);
+                    }
+                }
+            }
+            for (const int u: queue) {
+                visit[u] = INT_MAX;
+            }
+            for (const auto& [h, d]: labels[landmark]) {
+                hub[h] = INT_MAX;
+            }
+        });
+        for (int t = 0; t < batchEnd - batch; ++t) {
+            for (const auto& [u, entry]: found[t]) {
+                labels[u].push_back(entry); // Batches are in rank order, so every label stays sorted.
+            }
+        }
+    }
+    this->nodeCount = nc;
+    this->labelOffset.assign(nc + 1, 0);
+    for (int i = 0; i < nc; ++i) {
+        this->labelOffset[i + 1] = this->labelOffset[i] + labels[i].size();
+    }
+    this->labelHub.resize(this->labelOffset[nc]);
+    this->labelDistance.resize(this->labelOffset[nc]);
+    parallelFor(0, nc, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            std::size_t k = this->labelOffset[i];
+            for (const auto& [h, d]: labels[i]) {
+                this->labelHub[k] = h;
+                this->labelDistance[k++] = d;
+            }
+        }
+    });
+}
+
+DistanceOracle::DistanceOracle(const std::string& fileName) : DistanceOracle() {
+    std::ifstream ifs(fileName, std::ios::binary);
+    if (!ifs.is_open()) {
+        std::cerr << "File " << fileName << " does not exist." << std::endl;
+        return;
+    }
+    char magic[8];
+    int nc = 0;
+    std::size_t labelCount = 0;
+    ifs.read(magic, sizeof(magic));
+    ifs.read(reinterpret_cast<char*>(&nc), sizeof(nc));
+    ifs.read(reinterpret_cast<char*>(&labelCount), sizeof(labelCount));
+    if (!ifs || std::memcmp(magic, oracleMagic, sizeof(magic)) != 0 || nc < 0) {
+        std::cerr << "File " << fileName << " is not a distance oracle index." << std::endl;
+        return;
+    }
+    const std::uintmax_t expected = sizeof(magic) + sizeof(nc) + sizeof(labelCount) + (static_cast<std::uintmax_t>(nc) + 1) * sizeof(std::size_t) + 2 * static_cast<std::uintmax_t>(labelCount) * sizeof(int);
+    if (std::filesystem::file_size(fileName) != expected) {
+        std::cerr << "Distance oracle index " << fileName << " is truncated or broken." << std::endl;
+        return;
+    }
+    std::vector<std::size_t> offset(nc + 1);
+    std::vector<int> hub(labelCount), distance(labelCount);
+    ifs.read(reinterpret_cast<char*>(offset.data()), static_cast<std::streamsize>(offset.size() * sizeof(std::size_t)));
+    ifs.read(reinterpret_cast<char*>(hub.data()), static_cast<std::streamsize>(hub.size() * sizeof(int)));
+    ifs.read(reinterpret_cast<char*>(distance.data()), static_cast<std::streamsize>(distance.size() * sizeof(int)));
+    /* Every label must lie inside the hub arrays, or a query would read past them. */
+    if (!ifs.good() || offset[0] != 0 || offset[nc] != labelCount || !std::ranges::is_sorted(offset)) {
+        std::cerr << "Distance oracle index " << fileName << " is truncated or broken." << std::endl;
+        return;
+    }
+    this->nodeCount = nc;
+    this->labelOffset = std::move(offset);
+    this->labelHub = std::move(hub);
+    this->labelDistance = std::move(distance);
+}
+
+DistanceOracle::~DistanceOracle() = default;
+
+int DistanceOracle::getNodeCount() const {
+    return this->nodeCount;
+}
+
+std::size_t DistanceOracle::getLabelCount() const {
+    return this->labelHub.size();
+}
+
+std::size_t DistanceOracle::memoryUsage() const {
+    return sizeof(DistanceOracle) + this->labelOffset.capacity() * sizeof(std::size_t) + (this->labelHub.capacity() + this->labelDistance.capacity()) * sizeof(int);
+}
+
+int DistanceOracle::query(const int source, const int target) const {
+    if (source < 0 || source >= this->nodeCount || target < 0 || target >= this->nodeCount) {
+        std::cerr << "Cannot query [" << source << ", " << target << "] in oracle with " << this->nodeCount << " node(s)." << std::endl;
+        return -1;
+    }
+    /* Both labels are sorted by hub rank, a merge finds the best common hub. */
+    std::size_t i = this->labelOffset[source], j = this->labelOffset[target];
+    const std::size_t iEnd = this->labelOffset[source + 1], jEnd = this->labelOffset[target + 1];
+    int best = INT_MAX;
+    while (i < iEnd && j < jEnd) {
+        if (this->labelHub[i] == this->labelHub[j]) {
+            best = std::min(best, this->labelDistance[i++] + this->labelDistance[j++]);
+        } else if (this->labelHub[i] < this->labelHub[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return best == INT_MAX ? -1 : best;
+}
+
+bool DistanceOracle::save(const std::string& fileName) const {
+    std::ofstream ofs(fileName, std::ios::binary);
+    if (!ofs.is_open()) {
+        std::cerr << "Cannot open " << fileName << " to save the distance oracle." << std::endl;
+        return false;
+    }
+    const std::size_t labelCount = this->labelHub.size();
+    ofs.write(oracleMagic, sizeof(oracleMagic));
+    ofs.write(reinterpret_cast<const char*>(&this->nodeCount), sizeof(this->nodeCount));
+    ofs.write(reinterpret_cast<const char*>(&labelCount), sizeof(labelCount));
+    ofs.write(reinterpret_cast<const char*>(this->labelOffset.data()), static_cast<std::streamsize>(this->labelOffset.size() * sizeof(std::size_t)));
+    ofs.write(reinterpret_cast<const char*>(this->labelHub.data()), static_cast<std::streamsize>(labelCount * sizeof(int)));
+    ofs.write(reinterpret_cast<const char*>(this->labelDistance.data()), static_cast<std::streamsize>(labelCount * sizeof(int)));
+    return static_cast<bool>(ofs);
+}
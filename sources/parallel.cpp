@@ -0,0 +1,51 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include "../headers/parallel.h"
+
+static int userThreadCount = 0; // Zero means follow the hardware.
+static thread_local bool insideWorker = false;
+
+WorkerScope::WorkerScope() : previous(insideWorker) {
+    insideWorker = true;
+}
+
+WorkerScope::~WorkerScope() {
+    insideWorker = this->previous;
+}
+
+int threadCount() {
+    if (insideWorker) {
+        return 1;
+    }
+    if (userThreadCount > 0) {
+        return userThreadCount;
+    }
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return hardware > 0 ? hardware : 1;
+}
+
+void setThreadCount(const int count) {
+    userThreadCount = count > 0 ? count : 0;
+}
+
+std::vector<int> balancedPartition(const std::vector<std::size_t>& offsets, const int parts) {
+    // `offsets` is a CSR row pointer (size rows+1), every row costs its edges plus one.
+    const int rows = static_cast<int>(offsets.size()) - 1;
+    std::vector<int> bounds(parts + 1, rows);
+    bounds[0] = 0;
+    if (rows <= 0) {
+        return bounds;
+    }
+    const double total = static_cast<double>(offsets[rows] - offsets[0]) + rows;
+    int row = 0;
+    for (int p = 1; p < parts; ++p) {
+        const double target = total * p / parts;
+        while (row < rows && static_cast<double>(offsets[row] - offsets[0]) + row < target) {
+            row++;
+        }
+        bounds[p] = row;
+    }
+    return bounds;
+}
@@ -0,0 +1,226 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include "../headers/percolation.h"
+#include "../headers/parallel.h"
+#include "../headers/rng.h"
+
+namespace {
+    /* Union by size with path halving, `giant` follows the largest component. */
+    struct DisjointSet {
+        std::vector<int> parent, size;
+        int giant = 0;
+
+        explicit DisjointSet(const int nodeCount) : parent(nodeCount), size(nodeCount, 1) {
+            for (int i = 0; i < nodeCount; ++i) {
+                parent[i] = i;
+            }
+        }
+
+        int find(int node) {
+            while (parent[node] != node) {
+                parent[node] = parent[parent[node]];
+                node = parent[node];
+            }
+            return node;
+        }
+
+        void unite(int left, int right) {
+            left = find(left);
+            right = find(right);
+            if (left == right) {
+                return;
+            }
+            if (size[left] < size[right]) {
+                std::swap(left, right);
+            }
+            parent[right] = left;
+            size[left] += size[right];
+            giant = std::max(giant, size[left]);
+        }
+    };
+
+    /* The graph without weights, direction and self-loops: a symmetric CSR plus every edge once (left < right, sorted). */
+    struct Skeleton {
+        int nodeCount = 0;
+        std::vector<std::size_t> offset;
+        std::vector<int> target;
+        std::vector<std::pair<int, int>> edges;
+    };
+}
+
+static Skeleton buildSkeleton(const Graph& graph) {
+    Skeleton skeleton;
+    skeleton.nodeCount = graph.getNodeCount();
+    for (int i = 0; i < graph.getNodeCount(); ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (neighbor != i && (graph.isDirected() || neighbor > i)) {
+                skeleton.edges.emplace_back(std::min(i, neighbor), std::max(i, neighbor));
+            }
+        }
+    }
+    if (graph.isDirected()) {
+        std::ranges::sort(skeleton.edges); // Rows are sorted already for undirected graphs.
+        const auto [first, last] = std::ranges::unique(skeleton.edges); // Antiparallel edges join the same nodes.
+        skeleton.edges.erase(first, last);
+    }
+    skeleton.offset.assign(skeleton.nodeCount + 1, 0);
+    for (const auto& [left, right]: skeleton.edges) {
+        skeleton.offset[left + 1]++;
+        skeleton.offset[right + 1]++;
+    }
+    for (int i = 0; i < skeleton.nodeCount; ++i) {
+        skeleton.offset[i + 1] += skeleton.offset[i];
+    }
+    skeleton.target.resize(skeleton.offset[skeleton.nodeCount]);
+    std::vector<std::size_t> fill(skeleton.offset.begin(), skeleton.offset.end() - 1);
+    for (const auto& [left, right]: skeleton.edges) {
+        skeleton.target[fill[left]++] = right;
+        skeleton.target[fill[right]++] = left;
+    }
+    return skeleton;
+}
+
+/* `present` is scratch space of node count, `curve` gets order.size() + 1 entries. */
+static void siteCurve(const Skeleton& skeleton, const std::vector<int>& order, std::vector<char>& present, std::vector<int>& curve) {
+    DisjointSet set(skeleton.nodeCount);
+    const auto join = [&](const int node) {
+        present[node] = 1;
+        set.giant = std::max(set.giant, 1);
+        for (std::size_t k = skeleton.offset[node]; k < skeleton.offset[node + 1]; ++k) {
+            if (present[skeleton.target[k]]) {
+                set.unite(node, skeleton.target[k]);
+            }
+        }
+    };
+    present.assign(skeleton.nodeCount, 2);
+    for (const int node: order) {
+        present[node] = 0;
+    }
+    for (int i = 0; i < skeleton.nodeCount; ++i) {
+        if (present[i] == 2) {
+            join(i); // Never removed, so it is there from the start.
+        }
+    }
+    curve.resize(order.size() + 1);
+    curve[order.size()] = set.giant;
+    for (std::size_t k = order.size(); k-- > 0;) {
+        join(order[k]);
+        curve[k] = set.giant;
+    }
+}
+
+/* `order` holds edge ids of `skeleton.edges`, `removed` is scratch space of edge count. */
+static void bondCurve(const Skeleton& skeleton, const std::vector<std::size_t>& order, std::vector<char>& removed, std::vector<int>& curve) {
+    DisjointSet set(skeleton.nodeCount);
+    set.giant = skeleton.nodeCount ? 1 : 0;
+    removed.assign(skeleton.edges.size(), 0);
+    for (const std::size_t e: order) {
+        removed[e] = 1;
+    }
+    for (std::size_t e = 0; e < skeleton.edges.size(); ++e) {
+        if (!removed[e]) {
+            set.unite(skeleton.edges[e].first, skeleton.edges[e].second);
+        }
+    }
+    curve.resize(order.size() + 1);
+    curve[order.size()] = set.giant;
+    for (std::size_t k = order.size(); k-- > 0;) {
+        set.unite(skeleton.edges[order[k]].first, skeleton.edges[order[k]].second);
+        curve[k] = set.giant;
+    }
+}
+
+std::vector<int> sitePercolation(const Graph& graph, const std::vector<int>& order) {
+    std::vector<char> seen(graph.getNodeCount(), 0);
+    for (const int node: order) {
+        if (node < 0 || node >= graph.getNodeCount() || seen[node]) {
+            std::cerr << "Removal order must be distinct nodes in [0, " << graph.getNodeCount() << "), " << node << " is invalid." << std::endl;
+            return std::vector<int>(0);
+        }
+        seen[node] = 1;
+    }
+    std::vector<int> curve;
+    siteCurve(buildSkeleton(graph), order, seen, curve);
+    return curve;
+}
+
+std::vector<int> bondPercolation(const Graph& graph, const std::vector<std::pair<int, int>>& order) {
+    const Skeleton skeleton = buildSkeleton(graph);
+    std::vector<std::size_t> ids(order.size());
+    std::vector<char> seen(skeleton.edges.size(), 0);
+    for (std::size_t k = 0; k < order.size(); ++k) {
+        const std::pair<int, int> edge(std::min(order[k].first, order[k].second), std::max(order[k].first, order[k].second));
+        const auto it = std::ranges::lower_bound(skeleton.edges, edge);
+        if (it == skeleton.edges.end() || *it != edge || seen[it - skeleton.edges.begin()]) {
+            std::cerr << "Removal order must be distinct edges of the graph, [" << order[k].first << ", " << order[k].second << "] is invalid." << std::endl;
+            return std::vector<int>(0);
+        }
+        ids[k] = it - skeleton.edges.begin();
+        seen[ids[k]] = 1;
+    }
+    std::vector<int> curve;
+    bondCurve(skeleton, ids, seen, curve);
+    return curve;
+}
+
+std::vector<double> robustness(const Graph& graph, const std::string& strategy, const int repeats, const bool bond) {
+    if (strategy != "random" && strategy != "degree") {
+        std::cerr << "Unknown removal strategy " << strategy << ", only random and degree are supported." << std::endl;
+        return std::vector<double>(0);
+    }
+    if (repeats <= 0 || !graph.getNodeCount()) {
+        std::cerr << "Robustness needs a non-empty graph and at least one repeat, " << repeats << " is invalid." << std::endl;
+        return std::vector<double>(0);
+    }
+    const Skeleton skeleton = buildSkeleton(graph);
+    const std::size_t items = bond ? skeleton.edges.size() : skeleton.nodeCount;
+    /* Degree targeting removes the highest (initial) degree first, or the edge with the highest degree product. */
+    std::vector<long long> priority(items, 0);
+    if (strategy == "degree") {
+        const auto degree = [&skeleton](const int node) { return static_cast<long long>(skeleton.offset[node + 1] - skeleton.offset[node]); };
+        for (std::size_t k = 0; k < items; ++k) {
+            priority[k] = bond ? degree(skeleton.edges[k].first) * degree(skeleton.edges[k].second) : degree(static_cast<int>(k));
+        }
+    }
+    /* Repeat r uses its own stream, ties (all of them for random removal) are broken by a random key. Giant sizes are
+     * summed as integers, so the average does not depend on how repeats are shared among threads. */
+    const std::uint64_t key = gen.next64();
+    const int workers = std::max(1, std::min(threadCount(), repeats));
+    std::vector<std::vector<long long>> partial(workers, std::vector<long long>(items + 1, 0));
+    parallelFor(0, repeats, [&](const int begin, const int end, const int t) {
+        std::vector<std::pair<long long, std::uint64_t>> rank(items);
+        std::vector<std::size_t> order(items);
+        std::vector<int> nodeOrder, curve;
+        std::vector<char> scratch;
+        for (int r = begin; r < end; ++r) {
+            RandomStream local(key, r);
+            for (std::size_t k = 0; k < items; ++k) {
+                rank[k] = {-priority[k], local.next64()};
+                order[k] = k;
+            }
+            std::ranges::sort(order, [&rank](const std::size_t left, const std::size_t right) {
+                return rank[left] < rank[right];
+            });
+            if (bond) {
+                bondCurve(skeleton, order, scratch, curve);
+            } else {
+                nodeOrder.assign(order.begin(), order.end());
+                siteCurve(skeleton, nodeOrder, scratch, curve);
+            }
+            for (std::size_t k = 0; k <= items; ++k) {
+                partial[t][k] += curve[k];
+            }
+        }
+    });
+    std::vector<double> fraction(items + 1, 0.);
+    for (std::size_t k = 0; k <= items; ++k) {
+        long long total = 0;
+        for (const std::vector<long long>& p: partial) {
+            total += p[k];
+        }
+        fraction[k] = static_cast<double>(total) / repeats / skeleton.nodeCount;
+    }
+    return fraction;
+}
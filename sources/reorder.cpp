@@ -0,0 +1,319 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <cmath>
+
+#include "../headers/reorder.h"
+#include "../headers/parallel.h"
+
+namespace {
+    /* Symmetric CSR without weights and self-loops, both directions of a directed graph. */
+    struct Adjacency {
+        int nodeCount = 0;
+        std::vector<std::size_t> offset;
+        std::vector<int> target;
+
+        [[nodiscard]] int degree(const int i) const {
+            return static_cast<int>(offset[i + 1] - offset[i]);
+        }
+    };
+}
+
+static Adjacency buildAdjacency(const Graph& graph) {
+    Adjacency adjacency;
+    const int nodeCount = graph.getNodeCount();
+    adjacency.nodeCount = nodeCount;
+    adjacency.offset.assign(nodeCount + 1, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (neighbor == i) {
+                continue;
+            }
+            adjacency.offset[i + 1]++;
+            if (graph.isDirected()) {
+                adjacency.offset[neighbor + 1]++;
+            }
+        }
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        adjacency.offset[i + 1] += adjacency.offset[i];
+    }
+    adjacency.target.resize(adjacency.offset[nodeCount]);
+    std::vector<std::size_t> fill(adjacency.offset.begin(), adjacency.offset.end() - 1);
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            if (neighbor == i) {
+                continue;
+            }
+            adjacency.target[fill[i]++] = neighbor;
+            if (graph.isDirected()) {
+                adjacency.target[fill[neighbor]++] = i; // Antiparallel edges stay twice, which only weighs them more.
+            }
+        }
+    }
+    return adjacency;
+}
+
+/* Ids sorted by (degree, id), ascending or descending degree, by counting sort. */
+static std::vector<int> sortByDegree(const Adjacency& adjacency, const bool descending) {
+    int maxDegree = 0;
+    for (int i = 0; i < adjacency.nodeCount; ++i) {
+        maxDegree = std::max(maxDegree, adjacency.degree(i));
+    }
+    std::vector<int> start(maxDegree + 2, 0), sorted(adjacency.nodeCount);
+    for (int i = 0; i < adjacency.nodeCount; ++i) {
+        const int d = adjacency.degree(i);
+        start[(descending ? maxDegree - d : d) + 1]++;
+    }
+    for (int d = 0; d <= maxDegree; ++d) {
+        start[d + 1] += start[d];
+    }
+    for (int i = 0; i < adjacency.nodeCount; ++i) {
+        const int d = adjacency.degree(i);
+        sorted[start[descending ? maxDegree - d : d]++] = i;
+    }
+    return sorted;
+}
+
+/* Breadth-first levels from `root` inside its component, the last level and its depth. */
+static int lastLevel(const Adjacency& adjacency, const int root, std::vector<int>& level, std::vector<int>& queue, std::vector<int>& last) {
+    queue.assign(1, root);
+    level[root] = 0;
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        const int u = queue[head];
+        for (std::size_t k = adjacency.offset[u]; k < adjacency.offset[u + 1]; ++k) {
+            if (level[adjacency.target[k]] < 0) {
+                level[adjacency.target[k]] = level[u] + 1;
+                queue.push_back(adjacency.target[k]);
+            }
+        }
+    }
+    const int depth = level[queue.back()];
+    last.clear();
+    for (const int u: queue) {
+        if (level[u] == depth) {
+            last.push_back(u);
+        }
+        level[u] = -1;
+    }
+    return depth;
+}
+
+static std::vector<int> rcmOrder(const Adjacency& adjacency) {
+    const int nodeCount = adjacency.nodeCount;
+    std::vector<int> order, level(nodeCount, -1), queue, last;
+    std::vector<char> placed(nodeCount, 0);
+    order.reserve(nodeCount);
+    for (const int start: sortByDegree(adjacency, false)) {
+        if (placed[start]) {
+            continue;
+        }
+        /* George-Liu: hop to the lowest degree node of the last level while the depth keeps growing. */
+        int root = start, depth = lastLevel(adjacency, root, level, queue, last);
+        for (int round = 0; round < 8; ++round) {
+            const int next = *std::ranges::min_element(last, [&adjacency](const int left, const int right) {
+                return std::make_pair(adjacency.degree(left), left) < std::make_pair(adjacency.degree(right), right);
+            });
+            const int nextDepth = lastLevel(adjacency, next, level, queue, last);
+            if (nextDepth <= depth) {
+                break;
+            }
+            root = next;
+            depth = nextDepth;
+        }
+        /* Cuthill-McKee: breadth first, the unplaced neighbors of every node in ascending degree. */
+        const std::size_t first = order.size();
+        order.push_back(root);
+        placed[root] = 1;
+        std::vector<int> fresh;
+        for (std::size_t head = first; head < order.size(); ++head) {
+            const int u = order[head];
+            fresh.clear();
+            for (std::size_t k = adjacency.offset[u]; k < adjacency.offset[u + 1]; ++k) {
+                if (!placed[adjacency.target[k]]) {
+                    placed[adjacency.target[k]] = 1;
+                    fresh.push_back(adjacency.target[k]);
+                }
+            }
+            std::ranges::sort(fresh, [&adjacency](const int left, const int right) {
+                return std::make_pair(adjacency.degree(left), left) < std::make_pair(adjacency.degree(right), right);
+            });
+            order.insert(order.end(), fresh.begin(), fresh.end());
+        }
+    }
+    std::ranges::reverse(order);
+    return order;
+}
+
+static std::vector<int> hubOrder(const Adjacency& adjacency) {
+    const double mean = adjacency.nodeCount ? static_cast<double>(adjacency.target.size()) / adjacency.nodeCount : 0.;
+    std::vector<int> order;
+    order.reserve(adjacency.nodeCount);
+    for (int pass = 0; pass < 2; ++pass) {
+        for (int i = 0; i < adjacency.nodeCount; ++i) {
+            if ((adjacency.degree(i) > mean) == !pass) {
+                order.push_back(i);
+            }
+        }
+    }
+    return order;
+}
+
+namespace {
+    /* Gorder's unit heap: nodes in doubly linked buckets by score, a score moves by one in O(1) and the best bucket is
+     * found by walking down from the last maximum. */
+    class ScoreBuckets {
+    private:
+        std::vector<int> score, previous, next, head;
+        int top = 0;
+
+        void link(const int x) {
+            const int s = this->score[x];
+            if (s >= static_cast<int>(this->head.size())) {
+                this->head.resize(2 * s + 1, -1);
+            }
+            this->previous[x] = -1;
+            this->next[x] = this->head[s];
+            if (this->head[s] >= 0) {
+                this->previous[this->head[s]] = x;
+            }
+            this->head[s] = x;
+            this->top = std::max(this->top, s);
+        }
+
+    public:
+        explicit ScoreBuckets(const int nodeCount) : score(nodeCount, 0), previous(nodeCount, -1), next(nodeCount, -1), head(1, -1) {
+            for (int x = nodeCount - 1; x >= 0; --x) {
+                this->link(x); // Bucket 0 lists ids ascending.
+            }
+        }
+
+        void remove(const int x) {
+            if (this->previous[x] >= 0) {
+                this->next[this->previous[x]] = this->next[x];
+            } else {
+                this->head[this->score[x]] = this->next[x];
+            }
+            if (this->next[x] >= 0) {
+                this->previous[this->next[x]] = this->previous[x];
+            }
+        }
+
+        void add(const int x, const int delta) {
+            this->remove(x);
+            this->score[x] += delta;
+            this->link(x);
+        }
+
+        /* Node with the best positive score, -1 if every score is 0. */
+        int best() {
+            while (this->top > 0 && this->head[this->top] < 0) {
+                this->top--;
+            }
+            return this->top > 0 ? this->head[this->top] : -1;
+        }
+    };
+}
+
+/* Score of an unplaced node is its edges plus shared neighbors with the window. A node entering the window raises the
+ * score of its neighbors and their neighbors, leaving lowers them again. Neighbors above `hubLimit` degree are not
+ * expanded, a hub would touch most of the graph every step. */
+static std::vector<int> gorderOrder(const Adjacency& adjacency, const int window) {
+    const int nodeCount = adjacency.nodeCount;
+    const int hubLimit = std::max(32, static_cast<int>(std::sqrt(static_cast<double>(nodeCount))));
+    const std::vector<int> byDegree = sortByDegree(adjacency, true);
+    std::vector<int> order;
+    std::vector<char> placed(nodeCount, 0);
+    ScoreBuckets buckets(nodeCount);
+    order.reserve(nodeCount);
+    const auto touch = [&](const int v, const int delta) {
+        for (std::size_t k = adjacency.offset[v]; k < adjacency.offset[v + 1]; ++k) {
+            const int u = adjacency.target[k];
+            if (!placed[u]) {
+                buckets.add(u, delta);
+            }
+            if (adjacency.degree(u) > hubLimit) {
+                continue;
+            }
+            for (std::size_t l = adjacency.offset[u]; l < adjacency.offset[u + 1]; ++l) {
+                const int x = adjacency.target[l];
+                if (x != v && !placed[x]) {
+                    buckets.add(x, delta);
+                }
+            }
+        }
+    };
+    std::size_t fallback = 0;
+    for (int k = 0; k < nodeCount; ++k) {
+        int v = buckets.best();
+        if (v < 0) {
+            while (placed[byDegree[fallback]]) {
+                fallback++;
+            }
+            v = byDegree[fallback]; // Nothing related to the window, start from the largest remaining hub.
+        }
+        buckets.remove(v);
+        placed[v] = 1;
+        order.push_back(v);
+        touch(v, 1);
+        if (k >= window) {
+            touch(order[k - window], -1);
+        }
+    }
+    return order;
+}
+
+std::vector<int> nodeOrder(const Graph& graph, const std::string& method, const int window) {
+    if (method != "rcm" && method != "degree" && method != "hub" && method != "gorder") {
+        std::cerr << "Unknown reordering method " << method << ", only rcm, degree, hub and gorder are supported." << std::endl;
+        return std::vector<int>(0);
+    }
+    if (window < 1) {
+        std::cerr << "Window of gorder must be positive, " << window << " is given." << std::endl;
+        return std::vector<int>(0);
+    }
+    const Adjacency adjacency = buildAdjacency(graph);
+    if (method == "rcm") {
+        return rcmOrder(adjacency);
+    }
+    if (method == "degree") {
+        return sortByDegree(adjacency, true);
+    }
+    if (method == "hub") {
+        return hubOrder(adjacency);
+    }
+    return gorderOrder(adjacency, window);
+}
+
+Graph permute(const Graph& graph, const std::vector<int>& order) {
+    const int nodeCount = graph.getNodeCount();
+    std::vector<int> rank(nodeCount, -1);
+    bool valid = static_cast<int>(order.size()) == nodeCount;
+    for (std::size_t k = 0; valid && k < order.size(); ++k) {
+        valid = order[k] >= 0 && order[k] < nodeCount && rank[order[k]] < 0;
+        if (valid) {
+            rank[order[k]] = static_cast<int>(k);
+        }
+    }
+    if (!valid) {
+        std::cerr << "Order must be a permutation of the " << nodeCount << " node(s) of the graph." << std::endl;
+        return Graph();
+    }
+    return Graph(nodeCount, [&](const int i, std::vector<std::pair<int, double>>& neighbors) {
+        const std::vector<std::pair<int, double>>& old = graph.getNeighbors(order[i]);
+        neighbors.reserve(old.size());
+        for (const auto& [neighbor, weight]: old) {
+            neighbors.emplace_back(rank[neighbor], weight);
+        }
+    }, graph.isDirected());
+}
+
+std::pair<Graph, std::vector<int>> reorder(const Graph& graph, const std::string& method, const int window) {
+    std::vector<int> order = nodeOrder(graph, method, window);
+    if (order.empty() && graph.getNodeCount()) {
+        return {Graph(), std::vector<int>(0)};
+    }
+    Graph permuted = permute(graph, order);
+    return {std::move(permuted), std::move(order)};
+}
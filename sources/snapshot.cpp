@@ -0,0 +1,101 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include <climits>
+#include <memory>
+#include <thread>
+
+#include "../headers/snapshot.h"
+
+VersionedGraph::Snapshot::Snapshot(const VersionedGraph* owner, const int slot, const Version* version) : owner(owner), slot(slot), version(version) {}
+
+VersionedGraph::Snapshot::Snapshot(Snapshot&& other) noexcept : owner(other.owner), slot(other.slot), version(other.version) {
+    other.owner = nullptr;
+}
+
+VersionedGraph::Snapshot::~Snapshot() {
+    if (this->owner) {
+        this->owner->pinned[this->slot].store(0, std::memory_order_release);
+    }
+}
+
+const Graph& VersionedGraph::Snapshot::getGraph() const {
+    return this->version->graph;
+}
+
+std::uint64_t VersionedGraph::Snapshot::getVersion() const {
+    return this->version->number;
+}
+
+VersionedGraph::VersionedGraph(Graph graph) : current(new Version{std::move(graph), 1}), epoch(1) {
+    for (std::atomic<std::uint64_t>& slot: this->pinned) {
+        slot.store(0, std::memory_order_relaxed);
+    }
+}
+
+VersionedGraph::~VersionedGraph() {
+    for (const auto& [retiredAt, version]: this->retired) {
+        delete version;
+    }
+    delete this->current.load();
+}
+
+/* The slot is claimed with the epoch read before the version is, both sequentially consistent. A version replaced
+ * after that load is retired with a later epoch and stays, one replaced before it is never seen. */
+VersionedGraph::Snapshot VersionedGraph::pin() const {
+    static thread_local int hint = static_cast<int>(std::hash<std::thread::id>()(std::this_thread::get_id()) % readerSlots);
+    for (;;) {
+        for (int k = 0; k < readerSlots; ++k) {
+            const int slot = (hint + k) % readerSlots;
+            std::uint64_t expected = 0;
+            if (this->pinned[slot].load(std::memory_order_relaxed) == 0 && this->pinned[slot].compare_exchange_strong(expected, this->epoch.load())) {
+                hint = slot;
+                return Snapshot(this, slot, this->current.load());
+            }
+        }
+        std::this_thread::yield(); // Every slot is pinned, wait for a reader to leave.
+    }
+}
+
+/* `edit` gets a copy of the latest version, the copy shares all row blocks and only those it writes are copied. The
+ * copy is owned here until it is published, so an `edit` that throws leaves nothing behind. */
+std::uint64_t VersionedGraph::update(const std::function<void(Graph&)>& edit) {
+    std::lock_guard lock(this->writer);
+    Version* previous = this->current.load();
+    auto next = std::make_unique<Version>(Version{previous->graph, previous->number + 1});
+    edit(next->graph);
+    const std::uint64_t number = next->number;
+    this->retired.reserve(this->retired.size() + 1); // The only step below that can throw, done before publishing.
+    this->current.store(next.release());
+    this->retired.emplace_back(this->epoch.fetch_add(1) + 1, previous);
+    this->reclaimRetired();
+    return number;
+}
+
+std::size_t VersionedGraph::reclaim() {
+    std::lock_guard lock(this->writer);
+    return this->reclaimRetired();
+}
+
+std::size_t VersionedGraph::reclaimRetired() {
+    std::uint64_t oldest = ULLONG_MAX;
+    for (const std::atomic<std::uint64_t>& slot: this->pinned) {
+        const std::uint64_t e = slot.load();
+        if (e) {
+            oldest = std::min(oldest, e);
+        }
+    }
+    std::erase_if(this->retired, [oldest](const std::pair<std::uint64_t, Version*>& item) {
+        if (item.first > oldest) {
+            return false; // A reader pinned before it was replaced may still use it.
+        }
+        delete item.second;
+        return true;
+    });
+    return this->retired.size();
+}
+
+std::uint64_t VersionedGraph::getVersion() const {
+    return this->current.load()->number;
+}
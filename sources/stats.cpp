@@ -2,67 +2,231 @@
 // Created by Ivor on 2025/12/25.
 //
 
+#include <atomic>
+
 #include "../headers/stats.h"
 #include "../headers/algorithm.h"
+#include "../headers/bitmatrix.h"
+#include "../headers/distmatrix.h"
+#include "../headers/parallel.h"
+#include "../headers/subgraph.h"
 
-std::pair<std::pair<double, double>, std::vector<double>> degreeDistribution(const Graph& graph) {
+/* Batagelj-Zaversnik bucket peeling, O(n + m). `order` receives nodes in peeling (degeneracy) order. */
+template <typename Network>
+static std::vector<int> bucketCore(const Network& graph, std::vector<int>& order) {
+    const int nodeCount = graph.getNodeCount();
+    std::vector<int> degree(nodeCount, 0);
+    int maxDegree = 0;
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+            degree[i] += (neighbor != i); // Self-loops never support a core.
+        }
+        maxDegree = std::max(maxDegree, degree[i]);
+    }
+    std::vector<int> bin(maxDegree + 1, 0), position(nodeCount);
+    order.assign(nodeCount, 0);
+    for (int i = 0; i < nodeCount; ++i) {
+        bin[degree[i]]++;
+    }
+    for (int d = 0, start = 0; d <= maxDegree; ++d) {
+        const int count = bin[d];
+        bin[d] = start;
+        start += count;
+    }
+    for (int i = 0; i < nodeCount; ++i) {
+        position[i] = bin[degree[i]]++;
+        order[position[i]] = i;
+    }
+    for (int d = maxDegree; d > 0; --d) {
+        bin[d] = bin[d-1];
+    }
+    bin[0] = 0;
+    for (int p = 0; p < nodeCount; ++p) {
+        const int v = order[p];
+        for (const auto& [u, weight]: graph.getNeighbors(v)) {
+            if (degree[u] <= degree[v]) {
+                continue;
+            }
+            /* Swap `u` with the first node of its bucket, then shrink the bucket from the front. */
+            const int du = degree[u], pu = position[u], pw = bin[du], w = order[pw];
+            if (u != w) {
+                position[u] = pw;
+                order[pu] = w;
+                position[w] = pu;
+                order[pw] = u;
+            }
+            bin[du]++;
+            degree[u]--;
+        }
+    }
+    return degree;
+}
+
+/* Level-synchronous peeling: every level removes all nodes whose remaining degree has dropped to `k` at once. */
+template <typename Network>
+static std::vector<int> peelingCore(const Network& graph) {
+    const int nodeCount = graph.getNodeCount();
+    std::vector<int> degree(nodeCount, 0), core(nodeCount, -1), remain(nodeCount);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+                degree[i] += (neighbor != i);
+            }
+            remain[i] = i;
+        }
+    });
+    const int workers = threadCount();
+    std::vector<std::vector<int>> buffers(workers);
+    std::vector<int> frontier, kept;
+    for (int k = 0; !remain.empty(); ++k) {
+        kept.clear();
+        frontier.clear();
+        for (const int v: remain) {
+            if (~core[v]) {
+                continue; // Peeled at an earlier level.
+            }
+            (degree[v] <= k ? frontier : kept).push_back(v);
+        }
+        remain.swap(kept);
+        while (!frontier.empty()) {
+            parallelFor(0, static_cast<int>(frontier.size()), [&](const int begin, const int end, const int t) {
+                buffers[t].clear();
+                for (int f = begin; f < end; ++f) {
+                    const int v = frontier[f];
+                    core[v] = k;
+                    for (const auto& [u, weight]: graph.getNeighbors(v)) {
+                        if (u == v) {
+                            continue;
+                        }
+                        std::atomic_ref<int> du(degree[u]);
+                        if (du.load(std::memory_order_relaxed) <= k) {
+                            continue;
+                        }
+                        if (du.fetch_sub(1, std::memory_order_relaxed) == k + 1) {
+                            buffers[t].push_back(u); // Exactly one thread sees the drop to `k`.
+                        }
+                    }
+                }
+            });
+            frontier.clear();
+            for (std::vector<int>& buffer: buffers) {
+                frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+                buffer.clear();
+            }
+        }
+    }
+    return core;
+}
+
+/* Stats shared by a graph and a view: nodes outside a view are not counted, their ids only keep the arrays aligned. */
+template <typename Network>
+static std::pair<std::pair<double, double>, std::vector<double>> networkDegree(const Network& graph) {
     if (graph.isDirected()) {
         std::cout << "For unidirected network, stat out degree only." << std::endl;
     }
-    const int nodeCount = graph.getNodeCount();
+    const int nodeCount = graph.getNodeCount(), members = memberCount(graph);
     std::vector<double> degreeStats(nodeCount);
     double mean = 0., variance = 0.;
     for (int i = 0; i < nodeCount; ++i) {
+        if (!isMember(graph, i)) {
+            continue;
+        }
         const int degree = static_cast<int>(graph.getNeighbors(i).size());
-        degreeStats[degree] += 1./nodeCount;
-        mean += 1.*degree/nodeCount;
-        variance += 1.*degree*degree/nodeCount;
+        degreeStats[degree] += 1./members;
+        mean += 1.*degree/members;
+        variance += 1.*degree*degree/members;
     }
     variance -= mean*mean;
     return {{mean, variance}, degreeStats};
 }
 
-double clusterCoefficient(const Graph& graph) {
+/* Orient every edge along the degeneracy order, then each triangle is found once from its lowest node
+ * and every node scans no more than `degeneracy` forward neighbors. */
+template <typename Network>
+static std::vector<long long> listTriangles(const Network& graph) {
+    const int nodeCount = graph.getNodeCount();
+    std::vector<int> order, rank(nodeCount);
+    bucketCore(graph, order);
+    for (int i = 0; i < nodeCount; ++i) {
+        rank[order[i]] = i;
+    }
+    std::vector<std::vector<int>> forward(nodeCount);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, int) {
+        for (int i = begin; i < end; ++i) {
+            for (const auto& [neighbor, weight]: graph.getNeighbors(i)) {
+                if (rank[neighbor] > rank[i]) {
+                    forward[i].push_back(neighbor);
+                }
+            }
+        }
+    });
+    std::vector<long long> triangles(nodeCount, 0);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, int) {
+        std::vector<int> mark(nodeCount, -1);
+        for (int i = begin; i < end; ++i) {
+            for (const int j: forward[i]) {
+                mark[j] = i;
+            }
+            for (const int j: forward[i]) {
+                for (const int k: forward[j]) {
+                    if (mark[k] != i) {
+                        continue;
+                    }
+                    std::atomic_ref(triangles[i]).fetch_add(1, std::memory_order_relaxed);
+                    std::atomic_ref(triangles[j]).fetch_add(1, std::memory_order_relaxed);
+                    std::atomic_ref(triangles[k]).fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+    return triangles;
+}
+
+template <typename Network>
+static double networkCluster(const Network& graph) {
     if (graph.isDirected()) {
         std::cerr << "Undefined cluster coefficient for unidirected network." << std::endl;
         return 0.;
     }
     const int nodeCount = graph.getNodeCount();
+    if (!memberCount(graph)) {
+        return 0.;
+    }
+    /* Dense graphs count common neighbors on bit rows, an adjacency list scan costs far more per edge there. */
+    std::vector<long long> triangles;
+    if constexpr (std::is_same_v<Network, Graph>) {
+        if (isDense(graph)) {
+            triangles = BitMatrix(graph).triangles();
+        }
+    }
+    if (triangles.empty()) {
+        triangles = listTriangles(graph);
+    }
     double ret = 0.;
     for (int i = 0; i < nodeCount; ++i) {
-        std::vector<std::pair<int, double>> nli = graph.getNeighbors(i);
-        int lct = 0;
-        const int nei = static_cast<int>(nli.size());
-        for (int j = 0; j < nei; ++j) {
-            std::vector<std::pair<int, double>> nlj = graph.getNeighbors(nli[j].first);
-            for (int k = 0; k < j; ++k) {
-                auto it = std::ranges::find_if(nlj, [&](const std::pair<int, double>& obj) {
-                    return obj.first == nli[k].first;
-                });
-                lct += (it != nlj.end());
-            }
-        }
-        if (lct) {
-            ret += 1. * (lct << 1) / nei / (nei-1);
+        const int nei = static_cast<int>(graph.getNeighbors(i).size());
+        if (triangles[i]) {
+            ret += 2. * static_cast<double>(triangles[i]) / nei / (nei-1);
         }
     }
-    ret /= nodeCount;
+    ret /= memberCount(graph);
     return ret;
 }
 
 std::tuple<double, double, double> distance(const Graph& graph) {
-    const std::vector<std::vector<double>> distances = floyd(graph);
+    const DistanceMatrix distances(graph);
     int count = 0;
     const int nodeCount = graph.getNodeCount();
     double min = 1.e+150, max = -1.e+150, mean = 0.;
     for (int i = 0; i < nodeCount; ++i) {
         for (int j = 0; j < nodeCount; ++j) {
-            if (i == j || distances[i][j] > 1.e+100) {
+            const double d = distances.at(i, j);
+            if (i == j || d > 1.e+100) {
                 continue;
             }
-            min = (min < distances[i][j] ? min : distances[i][j]);
-            max = (max > distances[i][j] ? max : distances[i][j]);
-            mean += distances[i][j];
+            min = (min < d ? min : d);
+            max = (max > d ? max : d);
+            mean += d;
             count++;
         }
     }
@@ -73,3 +237,110 @@ std::tuple<double, double, double> distance(const Graph& graph) {
     }
     return {min, mean, max};
 }
+
+std::tuple<double, double, double> distance(const SubgraphView& view) {
+    const int nodeCount = view.getNodeCount();
+    bool hop = true, negative = false;
+    for (int i = 0; i < nodeCount; ++i) {
+        for (const auto& [neighbor, weight]: view.getNeighbors(i)) {
+            hop = hop && weight == 1.;
+            negative = negative || weight < 0.;
+        }
+    }
+    if (negative) {
+        return distance(inducedSubgraph(view).first); // Only Floyd Warshall handles it, on a compact copy.
+    }
+    /* One search per member, each row summed on its own and the rows added in id order. */
+    std::vector<double> rowMin(nodeCount, 1.e+150), rowMax(nodeCount, -1.e+150), rowSum(nodeCount, 0.);
+    std::vector<long long> rowCount(nodeCount, 0);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, int) {
+        std::vector<double> dist;
+        for (int i = begin; i < end; ++i) {
+            if (!view.contains(i)) {
+                continue;
+            }
+            distanceRow(view, i, dist, hop);
+            for (int j = 0; j < nodeCount; ++j) {
+                if (i == j || dist[j] > 1.e+100) {
+                    continue;
+                }
+                rowMin[i] = std::min(rowMin[i], dist[j]);
+                rowMax[i] = std::max(rowMax[i], dist[j]);
+                rowSum[i] += dist[j];
+                rowCount[i]++;
+            }
+        }
+    });
+    long long count = 0;
+    double min = 1.e+150, max = -1.e+150, mean = 0.;
+    for (int i = 0; i < nodeCount; ++i) {
+        min = std::min(min, rowMin[i]);
+        max = std::max(max, rowMax[i]);
+        mean += rowSum[i];
+        count += rowCount[i];
+    }
+    if (count) {
+        mean /= count;
+    } else {
+        min = max = mean = 0.;
+    }
+    return {min, mean, max};
+}
+
+template <typename Network>
+static std::pair<int, std::vector<int>> networkCore(const Network& graph, const bool parallel) {
+    if (graph.isDirected()) {
+        std::cerr << "Undefined k-core decomposition for unidirected network." << std::endl;
+        return {0, std::vector<int>(0)};
+    }
+    std::vector<int> order;
+    std::vector<int> core = parallel ? peelingCore(graph) : bucketCore(graph, order);
+    const int degeneracy = core.empty() ? 0 : *std::ranges::max_element(core);
+    return {degeneracy, core};
+}
+
+template <typename Network>
+static std::vector<int> networkOrder(const Network& graph) {
+    std::vector<int> order;
+    if (graph.isDirected()) {
+        std::cerr << "Undefined degeneracy order for unidirected network." << std::endl;
+        return order;
+    }
+    bucketCore(graph, order);
+    std::erase_if(order, [&graph](const int i) {
+        return !isMember(graph, i);
+    });
+    return order;
+}
+
+std::pair<std::pair<double, double>, std::vector<double>> degreeDistribution(const Graph& graph) {
+    return networkDegree(graph);
+}
+
+std::pair<std::pair<double, double>, std::vector<double>> degreeDistribution(const SubgraphView& view) {
+    return networkDegree(view);
+}
+
+double clusterCoefficient(const Graph& graph) {
+    return networkCluster(graph);
+}
+
+double clusterCoefficient(const SubgraphView& view) {
+    return networkCluster(view);
+}
+
+std::pair<int, std::vector<int>> coreNumber(const Graph& graph, const bool parallel) {
+    return networkCore(graph, parallel);
+}
+
+std::pair<int, std::vector<int>> coreNumber(const SubgraphView& view, const bool parallel) {
+    return networkCore(view, parallel);
+}
+
+std::vector<int> degeneracyOrder(const Graph& graph) {
+    return networkOrder(graph);
+}
+
+std::vector<int> degeneracyOrder(const SubgraphView& view) {
+    return networkOrder(view);
+}
@@ -0,0 +1,94 @@
+//
+// Created by Ivor on 2026/10/19.
+//
+
+#include "../headers/subgraph.h"
+#include "../headers/parallel.h"
+
+std::size_t SubgraphView::NeighborRange::size() const {
+    std::size_t count = 0;
+    for (auto it = this->begin(); it != this->end(); ++it) {
+        count++;
+    }
+    return count;
+}
+
+SubgraphView::SubgraphView(const Graph& graph, EdgeFilter filter) : graph(&graph), filter(std::move(filter)), memberCount(graph.getNodeCount()) {}
+
+SubgraphView::SubgraphView(const Graph& graph, const std::vector<int>& nodes, EdgeFilter filter) : SubgraphView(graph, std::move(filter)) {
+    this->member.assign(graph.getNodeCount(), 0);
+    this->memberCount = 0;
+    for (const int node: nodes) {
+        if (node < 0 || node >= graph.getNodeCount()) {
+            std::cerr << "Node " << node << " is not in this graph with " << graph.getNodeCount() << " node(s), it is left out of the view." << std::endl;
+            continue;
+        }
+        this->memberCount += !this->member[node];
+        this->member[node] = 1;
+    }
+}
+
+const Graph& SubgraphView::getGraph() const {
+    return *this->graph;
+}
+
+bool SubgraphView::isDirected() const {
+    return this->graph->isDirected();
+}
+
+int SubgraphView::getNodeCount() const {
+    return this->graph->getNodeCount();
+}
+
+int SubgraphView::getMemberCount() const {
+    return this->memberCount;
+}
+
+bool SubgraphView::contains(const int nodeIndex) const {
+    return nodeIndex >= 0 && nodeIndex < this->graph->getNodeCount() && (this->member.empty() || this->member[nodeIndex]);
+}
+
+SubgraphView::NeighborRange SubgraphView::getNeighbors(const int nodeIndex) const {
+    if (!this->contains(nodeIndex)) {
+        return {this, nodeIndex, nullptr, nullptr};
+    }
+    const std::vector<std::pair<int, double>>& neighbors = this->graph->getNeighbors(nodeIndex);
+    return {this, nodeIndex, neighbors.data(), neighbors.data() + neighbors.size()};
+}
+
+std::pair<Graph, std::vector<int>> inducedSubgraph(const SubgraphView& view) {
+    const int nodeCount = view.getNodeCount();
+    /* Ascending ids of the members: count per range, then every range writes from its prefix. */
+    const int workers = std::max(1, std::min(threadCount(), nodeCount));
+    std::vector<int> partial(workers + 1, 0), original(view.getMemberCount()), relabel(nodeCount, -1);
+    parallelFor(0, nodeCount, [&](const int begin, const int end, const int t) {
+        int count = 0;
+        for (int i = begin; i < end; ++i) {
+            count += view.contains(i);
+        }
+        partial[t + 1] = count;
+    });
+    for (int t = 0; t < workers; ++t) {
+        partial[t + 1] += partial[t];
+    }
+    parallelFor(0, nodeCount, [&](const int begin, const int end, const int t) {
+        int next = partial[t];
+        for (int i = begin; i < end; ++i) {
+            if (view.contains(i)) {
+                relabel[i] = next;
+                original[next++] = i;
+            }
+        }
+    });
+    /* Relabeling keeps the order, so every row comes out sorted. */
+    Graph graph(static_cast<int>(original.size()), [&](const int i, std::vector<std::pair<int, double>>& neighbors) {
+        for (const auto& [neighbor, weight]: view.getNeighbors(original[i])) {
+            neighbors.emplace_back(relabel[neighbor], weight);
+        }
+    }, view.isDirected());
+    return {std::move(graph), std::move(original)};
+}
+
+std::pair<Graph, std::vector<int>> inducedSubgraph(const Graph& graph, const std::vector<int>& nodes) {
+    return inducedSubgraph(SubgraphView(graph, nodes));
+}
@@ -1,15 +1,344 @@
 #include <windows.h>
+#include <chrono>
 #include <fstream>
+#include <thread>
 
 #include "../headers/Graph.h"
 #include "../headers/algorithm.h"
 #include "../headers/generator.h"
 #include "../headers/stats.h"
+#include "../headers/parallel.h"
+#include "../headers/community.h"
+#include "../headers/oracle.h"
+#include "../headers/edgefile.h"
+#include "../headers/ensemble.h"
+#include "../headers/percolation.h"
+#include "../headers/epidemic.h"
+#include "../headers/graphio.h"
+#include "../headers/distmatrix.h"
+#include "../headers/subgraph.h"
+#include "../headers/reorder.h"
+#include "../headers/bitmatrix.h"
+#include "../headers/snapshot.h"
 
 // void testForGraph_1(); Something has been updated that the old usages may not available.
 void testForGraph_2();
 void testForAlgorithm_1();
+void testForAlgorithm_2();
 void testForComplex_1();
+void testForCommunity_1();
+void testForOracle_1();
+void testForEnsemble_1();
+void testForPercolation_1();
+void testForEpidemic_1();
+void testForGraphio_1();
+void testForDistance_1();
+void testForSubgraph_1();
+void testForReorder_1();
+void testForBitMatrix_1();
+void testForSnapshot_1();
+
+void testForSnapshot_1() {
+    gen.seed(1024);
+    VersionedGraph versions(baScaleFree(20000, 4));
+    const VersionedGraph::Snapshot before = versions.pin(); // Pinning copies nothing.
+    const double cluster = clusterCoefficient(before.getGraph());
+    double during = 0.;
+    std::thread analysis([&before, &during]() {
+        during = clusterCoefficient(before.getGraph());
+    });
+    for (int k = 0; k < 200; ++k) {
+        versions.update([k](Graph& graph) {
+            graph.addEdge({k, 19999 - k, 1.}); // Only the blocks of node k and 19999 - k are copied.
+        });
+    }
+    analysis.join();
+    std::cout << "The pinned version " << before.getVersion() << " (1) keeps its cluster coefficient while 200 updates land: " << (during == cluster) << ", and still has " << before.getGraph().getEdgeCount() << " edges." << std::endl;
+    {
+        const VersionedGraph::Snapshot after = versions.pin();
+        std::cout << "The latest version is " << after.getVersion() << " (201) with " << after.getGraph().getEdgeCount() - before.getGraph().getEdgeCount() << " (200) more edges." << std::endl;
+    }
+    std::cout << "Versions replaced after the first one was pinned wait for it: " << versions.reclaim() << " (200) are retired." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    versions.update([](Graph& graph) {
+        graph.addEdge({0, 20000, 1.}); // Edits report their own errors, the version is still published.
+    });
+}
+
+void testForBitMatrix_1() {
+    const Graph full = fullConnect(200);
+    const BitMatrix bits(full);
+    std::cout << "Complete graph is dense (1): " << isDense(full) << ", node 0 has degree " << bits.degree(0) << " (199) in " << bits.memoryUsage() << " bytes, and sees node 7 (1): " << bits.hasEdge(0, 7) << "." << std::endl;
+    std::cout << "Node 0 lies on " << bits.triangles()[0] << " (19701) triangles, stats go through the bit rows by themselves: cluster coefficient " << clusterCoefficient(full) << " (1) and longest distance " << std::get<2>(distance(full)) << " (1)." << std::endl;
+    gen.seed(1024);
+    const Graph er = erRandom(2000, 0, .3);
+    const auto start = std::chrono::steady_clock::now();
+    const double cluster = clusterCoefficient(er);
+    std::cout << "Erdos-Renyi graph with p = 0.3 has cluster coefficient " << cluster << " (about 0.3), counted in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << "s, the same as on adjacency lists: " << (cluster == clusterCoefficient(SubgraphView(er))) << "." << std::endl;
+    std::vector<double> dist;
+    bits.hopRow(3, dist);
+    std::cout << "A bitset search from node 3 reaches node 199 in " << dist[199] << " (1) hop." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    static_cast<void>(bits.hasEdge(0, 200)); // Overflow node.
+    bits.hopRow(-1, dist); // Overflow source.
+    Graph directed(3, true);
+    static_cast<void>(BitMatrix(directed).triangles()); // Directed graph.
+}
+
+void testForReorder_1() {
+    Graph path(4);
+    path.addEdges({{0, 2, 1.}, {2, 3, 1.}, {3, 1, 1.}});
+    auto [banded, order] = reorder(path);
+    std::cout << "RCM lays the path out in line, new node 1 was node " << order[1] << " (3) and its neighbors are " << banded.getNeighbors(1)[0].first << " (0) and " << banded.getNeighbors(1)[1].first << " (2)." << std::endl;
+    /* A lattice with shuffled ids, then laid out again by every method. */
+    gen.seed(1024);
+    const Graph grid = lattice(400);
+    std::vector<int> shuffle(grid.getNodeCount());
+    for (int i = 0; i < grid.getNodeCount(); ++i) {
+        shuffle[i] = i;
+    }
+    std::ranges::shuffle(shuffle, gen);
+    const Graph mixed = permute(grid, shuffle);
+    for (const std::string method: {"none", "rcm", "degree", "hub", "gorder"}) {
+        auto start = std::chrono::steady_clock::now();
+        const Graph layout = method == "none" ? mixed : reorder(mixed, method).first;
+        const double orderTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        std::vector<double> dist;
+        for (int source = 0; source < 20; ++source) {
+            distanceRow(layout, source * 7919 % layout.getNodeCount(), dist);
+        }
+        const double rowTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        start = std::chrono::steady_clock::now();
+        const double cluster = clusterCoefficient(layout);
+        const double clusterTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << method << ": ordered in " << orderTime << "s, 20 distance rows in " << rowTime << "s, cluster coefficient " << cluster << " (0) in " << clusterTime << "s." << std::endl;
+    }
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    nodeOrder(path, "random"); // Unknown method.
+    nodeOrder(path, "gorder", 0); // Empty window.
+    permute(path, {0, 1, 1, 2}); // Not a permutation.
+}
+
+void testForSubgraph_1() {
+    Graph path(5);
+    path.addEdges({{0, 1, 1.}, {1, 2, 1.}, {2, 3, 1.}, {3, 4, 1.}});
+    const SubgraphView ends(path, {0, 1, 3, 4}); // Nothing is copied, node 2 is only masked.
+    std::cout << "Without the middle node the path is connected (0): " << dfs(ends) << ", node 0 reaches node 1 (1): " << bfs(ends, {0, 1}) << " but not node 4 (0): " << bfs(ends, {0, 4}) << "." << std::endl;
+    path.updateEdgeWeight({1, 2, 3.});
+    const SubgraphView light(path, [](int, int, const double weight) { return weight < 2.; });
+    std::cout << "The view keeps the edges lighter than 2 and its mean degree is " << degreeDistribution(light).first.first << " (1.2)." << std::endl;
+    auto [copy, original] = inducedSubgraph(path, {4, 3, 2});
+    std::cout << "Induced subgraph has " << copy.getNodeCount() << " (3) nodes and " << copy.getEdgeCount() << " (2) edges, its node 0 was node " << original[0] << " (2)." << std::endl;
+    gen.seed(1024);
+    Graph sf = baScaleFree(5000, 4);
+    std::vector<int> even;
+    for (int i = 0; i < 5000; i += 2) {
+        even.push_back(i);
+    }
+    const SubgraphView half(sf, even);
+    std::cout << "Stats on the view equal those of its copy: " << (clusterCoefficient(half) == clusterCoefficient(inducedSubgraph(half).first)) << ", and the view has degeneracy " << coreNumber(half).first << "." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    SubgraphView(path, {7}); // Node out of the graph.
+    bfs(ends, {0, 2}); // Masked node.
+    dfs(SubgraphView(path, std::vector<int>(0))); // Empty view.
+}
+
+void testForDistance_1() {
+    Graph path(5);
+    path.addEdges({{0, 1, 1.}, {1, 2, 1.}, {2, 3, 1.}, {3, 4, 1.}});
+    const DistanceMatrix hops(path);
+    std::cout << "Unweighted undirected graph keeps the lower triangle (1): " << hops.isTriangular() << " in " << hops.getWidth() << " (1) byte per entry, both ends are " << hops.at(4, 0) << " (4) hops apart." << std::endl;
+    path.updateEdgeWeight({1, 2, 2.5});
+    const DistanceMatrix weighted(path);
+    std::cout << "Weighted graph keeps " << weighted.getWidth() << " (8) bytes per entry, and the distance becomes " << weighted.at(0, 4) << " (5.5)." << std::endl;
+    gen.seed(1024);
+    Graph sf = baScaleFree(3000, 4);
+    const DistanceMatrix distances(sf);
+    distances.save("distance.ged");
+    const DistanceMatrix loaded("distance.ged");
+    std::cout << "The matrix of 3000 nodes takes " << distances.memoryUsage() << " bytes instead of " << 3000 * 3000 * 8 << ", and reads back the same: " << (loaded.at(17, 2999) == distances.at(17, 2999)) << "." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    static_cast<void>(hops.at(0, 5)); // Overflow node.
+    DistanceMatrix("not_exist.ged"); // Missing file.
+    DistanceMatrix("graphio.csv"); // Not a distance matrix.
+}
+
+void testForGraphio_1() {
+    std::ofstream ofs("graphio.csv");
+    ofs << "4,3,True\n0,1,1.5\n1,2,2\n 2 , 3 , 0.5 \r\n"; // Blanks and Windows line ends are fine.
+    ofs.close();
+    Graph graph = readCsv("graphio.csv");
+    std::cout << "The imported graph is directed (1): " << graph.isDirected() << ", with " << graph.getEdgeCount() << " (3) edges, and the last weight is " << graph.getNeighbors(2)[0].second << " (0.5)." << std::endl;
+    saveBinary(graph, "graphio.geg");
+    const GraphView view("graphio.geg", true); // Mapped, nothing is parsed.
+    std::cout << "The binary graph has " << view.getEdgeCount() << " (3) edges, node 1 points to " << view.getNeighbors(1)[0] << " (2) with weight " << view.getWeights(1)[0] << " (2), and it converts back: " << (view.toGraph().getNeighbors(0) == graph.getNeighbors(0)) << "." << std::endl;
+    gen.seed(1024);
+    Graph sf = baScaleFree(2000, 4);
+    exportNodes(sf, "nodes_graphio.csv"); // One search per row, formatted on all threads and written in order.
+    exportEdges(sf, "edges_graphio.csv");
+    std::cout << "Exported edges read back to the same graph: " << (readCsv("edges_graphio.csv").getNeighbors(0) == sf.getNeighbors(0)) << "." << std::endl;
+    std::cout << "Streamed through small blocks, they read back the same as well: " << (streamCsv("edges_graphio.csv", 4096).getNeighbors(0) == sf.getNeighbors(0)) << "." << std::endl;
+    ofs.open("graphio.txt");
+    ofs << "# Undirected graph: SNAP ids from 1\n1\t2\n2\t3\n";
+    ofs.close();
+    Graph snap = readSnap("graphio.txt"); // Ids from 1 are shifted, which is logged.
+    std::cout << "SNAP edge list is undirected (0): " << snap.isDirected() << ", with " << snap.getNodeCount() << " (3) nodes." << std::endl;
+    ofs.open("graphio.txt");
+    ofs << "# Undirected graph: every edge from both ends but the last one\n0 1 2.5\n1 0 2.5\n1 2\n2 1\n3 2\n";
+    ofs.close();
+    snap = readSnap("graphio.txt");
+    std::cout << "Edges listed from both ends are kept once: " << snap.getEdgeCount() << " (3) edges, and edge [0, 1] weighs " << snap.getNeighbors(0)[0].second << " (2.5)." << std::endl;
+    ofs.open("graphio.mtx");
+    ofs << "%%MatrixMarket matrix coordinate real general\n% comment\n3 3 2\n1 2 0.5\n3 1 2\n";
+    ofs.close();
+    std::cout << "Matrix Market entry (3, 1) becomes edge [2, 0] with weight " << readMatrixMarket("graphio.mtx").getNeighbors(2)[0].second << " (2)." << std::endl;
+    ofs.open("graphio.graph");
+    ofs << "% METIS\n3 2\n2 3\n1\n1\n";
+    ofs.close();
+    std::cout << "METIS graph has " << readMetis("graphio.graph").getEdgeCount() << " (2) edges." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    ofs.open("graphio.csv");
+    ofs << "4,3,False\n0,1,1\n1;2;1\n2,7,1\n"; // Line 3 is malformed and line 4 is out of the graph.
+    ofs.close();
+    readCsv("graphio.csv");
+    streamCsv("graphio.csv"); // The same lines reported from the pipeline.
+    streamCsv("graphio.csv", 0); // Empty blocks.
+    readCsv("not_exist.csv"); // Missing file.
+    GraphView("graphio.csv"); // Not a binary graph.
+    std::fstream corrupt("graphio.geg", std::ios::binary | std::ios::in | std::ios::out);
+    const double otherWeight = 3.;
+    corrupt.seekp(-static_cast<std::streamoff>(sizeof(double)), std::ios::end); // The last weight.
+    corrupt.write(reinterpret_cast<const char*>(&otherWeight), sizeof(otherWeight));
+    corrupt.flush();
+    GraphView("graphio.geg", true); // Checksum mismatch, seen only with verify.
+    const std::uint64_t farOffset = 100;
+    corrupt.seekp(64 + 2 * sizeof(std::uint64_t)); // offset[2], after the 64-byte header.
+    corrupt.write(reinterpret_cast<const char*>(&farOffset), sizeof(farOffset));
+    corrupt.close();
+    GraphView("graphio.geg"); // Offsets out of order, checked on every open.
+    ofs.open("graphio.mtx");
+    ofs << "%%MatrixMarket matrix array real general\n2 2\n1\n2\n3\n4\n";
+    ofs.close();
+    readMatrixMarket("graphio.mtx"); // Dense array is not a graph.
+    ofs.open("graphio.graph");
+    ofs << "3 2\n2\n1 9\n";
+    ofs.close();
+    readMetis("graphio.graph"); // Node out of the graph and rows missing.
+}
+
+void testForEpidemic_1() {
+    gen.seed(1024);
+    Graph sf = baScaleFree(10000, 4);
+    const EpidemicResult cascade = simulate(sf, "ic", 1., 1., {0});
+    std::cout << "Independent cascade with certain activation reaches every node: " << cascade.outbreakSize[0] << ", in " << cascade.infected.size() - 1 << " steps." << std::endl;
+    const EpidemicResult sir = simulate(sf, "sir", .1, .2, {}, 200); // Every realization has its own random stream.
+    std::cout << "After 200 SIR realizations, the final recovered count " << sir.recovered.back() << " equals the average outbreak size, and nobody is infected at the end: " << sir.infected.back() << "." << std::endl;
+    const EpidemicResult sis = simulate(sf, "sis", .2, .3, {0, 1, 2}, 4, 200);
+    std::cout << "SIS stays endemic, " << sis.infected.back() << " node(s) are still infected after 200 steps." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    simulate(sf, "seir", .1); // Unknown model.
+    simulate(sf, "sir", 1.5); // Invalid probability.
+    simulate(sf, "sir", .1, 1., {10000}); // Overflow seed.
+}
+
+void testForPercolation_1() {
+    Graph path(5);
+    path.addEdges({{0, 1, 1.}, {1, 2, 1.}, {2, 3, 1.}, {3, 4, 1.}});
+    const std::vector<int> cut = sitePercolation(path, {2, 0});
+    std::cout << "Removing the middle of a 5-node path leaves giant component " << cut[1] << " (2), then removing an end leaves " << cut[2] << " (2)." << std::endl;
+    std::cout << "Removing its first edge leaves giant component " << bondPercolation(path, {{1, 0}})[1] << " (4)." << std::endl;
+    gen.seed(1024);
+    Graph sf = baScaleFree(10000, 4);
+    const std::vector<double> failure = robustness(sf, "random", 8), attack = robustness(sf, "degree", 8); // Whole curves, one union-find pass each.
+    std::cout << "Barabási-Albert network keeps " << failure[1000] << " of its nodes connected after 10% random failures, but only " << attack[1000] << " after 10% hub attacks." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    sitePercolation(path, {1, 1}); // Repeated node.
+    bondPercolation(path, {{0, 4}}); // Not an edge.
+    robustness(path, "betweenness"); // Unknown strategy.
+}
+
+void testForEnsemble_1() {
+    const auto generate = []() { return baScaleFree(1000, 4); };
+    setThreadCount(1);
+    const std::vector<EnsembleRow> rows1 = ensemble(generate, 1, 40, {"degree", "core"});
+    setThreadCount(4);
+    const std::vector<EnsembleRow> rows4 = ensemble(generate, 1, 40, {"degree", "core"}, "ensemble.csv"); // Every seed has its own graph, threads do not change the result.
+    setThreadCount(0);
+    std::cout << "40 Barabási-Albert networks have degeneracy " << rows4[1].mean << " and average degree " << rows4[0].mean << " in [" << rows4[0].lower << ", " << rows4[0].upper << "]." << std::endl;
+    std::cout << "Same seeds give the same ensemble on 1 and 4 threads: " << std::ranges::equal(rows1, rows4, [](const EnsembleRow& left, const EnsembleRow& right) {
+        return left.mean == right.mean && left.variance == right.variance;
+    }) << ", see \"ensemble.csv\" for P(k)." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    ensemble(generate, 1, 0, {"degree"}); // No seed.
+    ensemble(generate, 1, 4, {"diameter"}); // Unknown statistic.
+}
+
+void testForOracle_1() {
+    gen.seed(1024);
+    Graph sf = baScaleFree(2000, 4);
+    DistanceOracle oracle(sf); // Index once, then each query only merges two labels.
+    std::cout << "The index has " << oracle.getLabelCount() << " label(s) in " << oracle.memoryUsage() << " byte(s)." << std::endl;
+    const auto dist = floyd(sf);
+    std::cout << "Distance between 0 and 1999 is " << oracle.query(0, 1999) << ", same as Floyd Warshall: " << dist[0][1999] << "." << std::endl;
+    oracle.save("oracle.pll");
+    const DistanceOracle loaded("oracle.pll");
+    std::cout << "The loaded index answers the same: " << loaded.query(0, 1999) << "." << std::endl;
+    Graph graph(4);
+    graph.addEdge({0, 1, 1.});
+    std::cout << "Unreachable pair gets -1: " << DistanceOracle(graph).query(0, 3) << "." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    static_cast<void>(oracle.query(0, 5000)); // Overflow error.
+    DistanceOracle(Graph(5, true)); // Directed graph.
+    DistanceOracle("not_exist.pll"); // Missing file.
+    std::fstream corrupt("oracle.pll", std::ios::binary | std::ios::in | std::ios::out);
+    const std::size_t farOffset = 1ULL << 40;
+    corrupt.seekp(8 + sizeof(int) + 2 * sizeof(std::size_t)); // offset[1], right after the header and offset[0].
+    corrupt.write(reinterpret_cast<const char*>(&farOffset), sizeof(farOffset));
+    corrupt.close();
+    DistanceOracle("oracle.pll"); // Label offsets out of order.
+}
+
+void testForCommunity_1() {
+    Graph graph(10);
+    graph.addEdges({{0, 1, 1.}, {0, 2, 1.}, {0, 3, 1.}, {0, 4, 1.}, {1, 2, 1.}, {1, 3, 1.}, {1, 4, 1.}, {2, 3, 1.}, {2, 4, 1.}, {3, 4, 1.}});
+    graph.addEdges({{5, 6, 1.}, {5, 7, 1.}, {5, 8, 1.}, {5, 9, 1.}, {6, 7, 1.}, {6, 8, 1.}, {6, 9, 1.}, {7, 8, 1.}, {7, 9, 1.}, {8, 9, 1.}});
+    graph.addEdge({4, 5, 1.}); // Two 5-cliques joined by a bridge.
+    auto [mod, com] = louvain(graph);
+    std::cout << "Louvain splits the bridge, node 0 and 4 are in community " << com[0] << " and " << com[4] << ", node 5 and 9 are in community " << com[5] << " and " << com[9] << "." << std::endl;
+    std::cout << "Modularity of the two cliques is about 0.4524: " << mod << ", and it can be recalculated: " << modularity(graph, com) << "." << std::endl;
+    std::cout << "Everything in one community has zero modularity: " << modularity(graph, std::vector<int>(10, 0)) << "." << std::endl;
+    gen.seed(1024);
+    Graph sf = baScaleFree(2000, 6);
+    std::cout << "Barabási-Albert scale-free network after one pass: " << louvain(sf, 1).first << ", after all passes: " << louvain(sf).first << "." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    louvain(Graph()); // Empty error.
+    modularity(graph, {0, 1}); // Size mismatch.
+    graph.updateEdgeWeight({4, 5, -1.});
+    louvain(graph); // Negative weight.
+}
 
 void testForComplex_1() {
     gen.seed(1024); // Make it repeatable.
@@ -21,6 +350,7 @@ void testForComplex_1() {
     std::cout << "Average degree: " << fcd.first.first << ", variance of degree: " << fcd.first.second << "." << std::endl;
     std::cout << "Cluster coefficient: " << fcc << "." << std::endl;
     std::cout << "Average distance: " << std::get<1>(fcl) << ", distance distribution area: [" << std::get<0>(fcl) << ", " << std::get<2>(fcl) << "]." << std::endl;
+    std::cout << "The full connected network with 3000 nodes is written row by row, it has " << fullConnect(3000).getEdgeCount() << " (3000*2999/2) edges." << std::endl;
     Graph lt = lattice(40); // 40*40 with period boundary condition 2D-lattice network.
     std::pair<std::pair<double, double>, std::vector<double>> ltd = degreeDistribution(lt);
     double ltc = clusterCoefficient(lt);
@@ -37,6 +367,23 @@ void testForComplex_1() {
     Graph erl = erRandom(200, -1, .04);
     Graph erh = erRandom(200, -1, .40); // Erdös-Rényi graph with different connect rate.
     std::cout << "Erdös-Rényi with lower connect rate will have larger average distance (" << std::get<1>(distance(erl)) << ") than the higher one (" << std::get<1>(distance(erh)) << ")." << std::endl;
+    Graph ers = erRandom(100000, -1, 1.e-4); // Sparse one is generated by skipping, its cost follows the edges.
+    std::cout << "Erdös-Rényi with 100000 nodes and 1e-4 connect rate has " << ers.getEdgeCount() << " edges, about 499995 expected." << std::endl;
+    gen.seed(2048);
+    setThreadCount(1);
+    Graph ers1 = erRandom(3000, -1, .01);
+    gen.seed(2048);
+    setThreadCount(4);
+    Graph ers4 = erRandom(3000, -1, .01); // Every chunk has its own random stream, threads do not change the graph.
+    setThreadCount(0);
+    bool same = ers1.getEdgeCount() == ers4.getEdgeCount();
+    for (int i = 0; i < 3000; ++i) {
+        same = same && ers1.getNeighbors(i) == ers4.getNeighbors(i);
+    }
+    std::cout << "Same seed gives the same Erdös-Rényi graph on 1 and 4 threads: " << same << "." << std::endl;
+    gen.seed(2048);
+    EdgeFileWriter file("er.edges", 10000); // A small buffer, so the edges are merged from several sorted runs.
+    std::cout << "Streaming it into a file writes " << erRandom(file, 3000, .01) << " edges, and reading it back gives the same graph: " << (readEdgeFile("er.edges").getNeighbors(7) == ers1.getNeighbors(7)) << "." << std::endl;
     wsSmallWorld(lt, .5); // Make the lattice be small world.
     double swd = std::get<2>(distance(lt));
     std::cout << "Small world network satisfied six-degree of separation theorem, so the longest distance is " << swd << " for 1600 nodes with " << ltd.first.first << " average degree." << std::endl;
@@ -49,13 +396,62 @@ void testForComplex_1() {
     }
     outfile.close();
     std::cout << "Barabási-Albert scale-free network has power-law degree distribution, see \"out.csv\"." << std::endl;
+    std::pair<int, std::vector<int>> sfc = coreNumber(sf), sfp = coreNumber(sf, true);
+    std::cout << "Barabási-Albert scale-free network grows from a full connected seed with 6 nodes, so its degeneracy (5) is " << sfc.first << ", and parallel peeling agrees: " << (sfc.second == sfp.second) << "." << std::endl;
+    Graph rm = rmat(14); // 16384 nodes with Graph500 parameters.
+    std::pair<std::pair<double, double>, std::vector<double>> rmd = degreeDistribution(rm);
+    std::cout << "R-MAT graph is skewed, average degree is " << rmd.first.first << " but variance of degree is " << rmd.first.second << "." << std::endl;
+    std::vector<int> sfDegrees(1000);
+    for (int i = 0; i < 1000; ++i) {
+        sfDegrees[i] = static_cast<int>(sf.getNeighbors(i).size());
+    }
+    Graph cm = configurationModel(sfDegrees); // Same degrees as the scale-free one, random otherwise.
+    std::cout << "Configuration model keeps the degrees but not the structure, its degeneracy is " << coreNumber(cm).first << " and it has " << cm.getEdgeCount() << " edges (at most " << sf.getEdgeCount() << ")." << std::endl;
     /********************************************************************************************************************************/
     std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
     Sleep(2000);
     ring(-1), ring(4, 4), ring(10, 3), ring(10, 0);
     oddRegular(10, 4), oddRegular(10, 1), oddRegular(10, 11), oddRegular(9, 5);
     baScaleFree(10, 12), baScaleFree(11, 7);
+    rmat(0), rmat(10, 16, .6, .3, .3);
+    configurationModel({1, 2});
     clusterCoefficient(Graph(5, true));
+    coreNumber(Graph(5, true));
+}
+
+void testForAlgorithm_2() {
+    Graph graph(4, true);
+    graph.addEdges({{0, 1, 1.}, {1, 2, 1.}, {2, 0, 1.}, {2, 3, 1.}}); // A directed triangle with a dangling tail.
+    std::vector<double> rank = pageRank(graph);
+    std::cout << "PageRank of node 2 is the largest (about 0.3079): " << rank[2] << ", node 0 and 3 share the same value: " << rank[0] << " and " << rank[3] << "." << std::endl;
+    setThreadCount(3);
+    std::cout << "More threads give the same result: " << pageRank(graph)[2] << "." << std::endl;
+    setThreadCount(0); // Back to hardware concurrency.
+    std::cout << "Personalized on node 0, it keeps the most rank: " << pageRank(graph, .85, {1., 0., 0., 0.})[0] << "." << std::endl;
+    graph.addEdge({3, 0, 1.});
+    std::vector<double> warm = pageRank(graph, .85, {}, rank); // Warm start from the last result after a small edit.
+    std::cout << "After adding edge [3, 0], node 0 gains rank: " << warm[0] << " > " << rank[0] << "." << std::endl;
+    Graph weighted(5);
+    weighted.addEdges({{0, 1, 1.}, {1, 2, 1.}, {2, 3, 1.}, {3, 4, 1.}, {0, 4, 5.}}); // A path is shorter than the direct edge.
+    auto [hop, hopPath] = bidirectionalBfs(weighted, {0, 4}, true);
+    auto [len, lenPath] = bidirectionalDijkstra(weighted, {0, 4}, true);
+    std::cout << "Node 4 is " << hop << " hop away from node 0 through " << hopPath.size() << " nodes, but the shortest weighted distance is " << len << " through " << lenPath.size() << " nodes." << std::endl;
+    std::vector<double> batch = batchDistance(weighted, {{0, 4}, {1, 3}, {4, 4}}, true);
+    std::cout << "Batched weighted distances: " << batch[0] << ", " << batch[1] << " and " << batch[2] << "." << std::endl;
+    Graph apart(2);
+    std::cout << "Unreachable is 1e+150 for hops as for weights: " << bidirectionalBfs(apart, {0, 1}).first << " and " << bidirectionalDijkstra(apart, {0, 1}).first << "." << std::endl;
+    /********************************************************************************************************************************/
+    std::cout << "Then you will see some errors that for incorrect calls." << std::endl;
+    Sleep(2000);
+    pageRank(Graph()); // Empty error.
+    pageRank(graph, 1.5); // Damping out of range.
+    pageRank(graph, .85, {1., 0.}); // Personalization size mismatch.
+    pageRank(graph, .85, {0., 0., 0., 0.}); // No positive teleport weight.
+    bidirectionalBfs(graph, {0, 100}); // Overflow error.
+    const std::vector<double> partial = batchDistance(weighted, {{0, 100}, {0, 4}}, true); // Only the bad pair is left out.
+    std::cout << "The bad pair gets " << partial[0] << " (-1) and the other one is still answered: " << partial[1] << " (4)." << std::endl;
+    weighted.updateEdgeWeight({1, 2, -1.});
+    bidirectionalDijkstra(weighted, {0, 4}); // Negative weight.
 }
 
 void testForAlgorithm_1() {